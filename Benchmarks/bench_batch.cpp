@@ -0,0 +1,67 @@
+#include "Kernel/batch_solver.h"
+#include "Kernel/max_flow.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<FlowInstance> GenInstances(size_t count) {
+    std::mt19937 gen(239);
+    std::vector<FlowInstance> instances(count);
+    for (auto& instance : instances) {
+        instance.n = gen() % 9 + 2;
+        for (size_t i = 1; i < instance.n; i++) {
+            instance.edges.push_back({gen() % i, i, gen() % 100 + 1});
+        }
+        for (size_t i = 0; i < instance.n; i++) {
+            size_t u = gen() % instance.n, to = gen() % instance.n;
+            if (u != to) {
+                instance.edges.push_back({u, to, gen() % 100 + 1});
+            }
+        }
+    }
+    return instances;
+}
+
+template <class Func>
+double Measure(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main() {
+    const size_t count = 1000000;
+    auto instances = GenInstances(count);
+    std::cout << count << " instances with at most 10 vertices\n";
+    size_t total_flow = 0;
+    double time = Measure([&]() {
+        for (const auto& instance : instances) {
+            MaxFlow max_flow(instance.n, instance.edges);
+            max_flow.RunRequest();
+            total_flow += max_flow.GetMinCut().capacity;
+        }
+    });
+    std::cout << "  MaxFlow per instance: " << count / time << " instances/s, total flow "
+              << total_flow << '\n';
+    for (size_t threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+        BatchSolver solver(threads);
+        for (bool with_edge_flows : {false, true}) {
+            total_flow = 0;
+            time = Measure([&]() {
+                for (const auto& result : solver.Solve(instances, with_edge_flows)) {
+                    total_flow += result.flow;
+                }
+            });
+            std::cout << "  " << threads << " threads" << (with_edge_flows ? ", edge flows" : "")
+                      << ": " << count / time << " instances/s, total flow " << total_flow
+                      << '\n';
+        }
+    }
+    return 0;
+}
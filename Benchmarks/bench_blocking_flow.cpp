@@ -0,0 +1,93 @@
+#include "Kernel/dinic.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<BasicEdge> GenCorridor(size_t width, size_t length) {
+    std::mt19937_64 gen(239);
+    std::vector<BasicEdge> edges;
+    size_t sink = width * length + 1;
+    for (size_t y = 0; y < width; y++) {
+        edges.push_back({0, y * length + 1, size_t{1} << 40});
+        edges.push_back({(y + 1) * length, sink, size_t{1} << 40});
+        for (size_t x = 0; x + 1 < length; x++) {
+            size_t vertex = y * length + x + 1;
+            edges.push_back({vertex, vertex + 1, gen() % 1000 + 1});
+            if (y + 1 < width) {
+                edges.push_back({vertex, vertex + length, gen() % 1000 + 1});
+                edges.push_back({vertex + length, vertex, gen() % 1000 + 1});
+            }
+        }
+    }
+    return edges;
+}
+
+std::vector<BasicEdge> GenSharedCorridor(size_t length, size_t fan) {
+    std::vector<BasicEdge> edges;
+    size_t sink = length + fan + 1;
+    for (size_t vertex = 0; vertex < length; vertex++) {
+        edges.push_back({vertex, vertex + 1, fan});
+    }
+    for (size_t i = 1; i <= fan; i++) {
+        edges.push_back({length, length + i, 1});
+        edges.push_back({length + i, sink, 1});
+    }
+    return edges;
+}
+
+std::vector<BasicEdge> GenRandomGraph(size_t n, size_t degree) {
+    std::mt19937_64 gen(239);
+    std::vector<BasicEdge> edges;
+    for (size_t i = 0; i < n * degree; i++) {
+        size_t u = gen() % n, to = gen() % n;
+        if (u != to) {
+            edges.push_back({u, to, gen() % 1000 + 1});
+        }
+    }
+    return edges;
+}
+
+template <class Func>
+double Measure(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RunGraph(const std::string& name, size_t n, const std::vector<BasicEdge>& edges) {
+    std::cout << name << ", " << n << " vertices, " << edges.size() << " edges\n";
+    for (auto [blocking_flow, blocking_flow_name] :
+         {std::pair{BlockingFlow::Augmenting, "augmenting:    "},
+          std::pair{BlockingFlow::DynamicTrees, "dynamic trees: "},
+          std::pair{BlockingFlow::Adaptive, "adaptive:      "}}) {
+        ResidualNetwork network(n, edges);
+        Dinic<size_t> dinic(blocking_flow);
+        size_t flow;
+        double time = Measure([&]() { flow = dinic.Run(network, 0, n - 1); });
+        std::cout << "  " << blocking_flow_name << time << " s, flow " << flow << ", "
+                  << dinic.GetStatistics().phases << " phases, "
+                  << dinic.GetStatistics().dynamic_tree_phases << " with dynamic trees\n";
+    }
+}
+}  // namespace
+
+int main() {
+    for (auto [width, length] : {std::pair{size_t{4}, size_t{50000}},
+                                 std::pair{size_t{16}, size_t{20000}},
+                                 std::pair{size_t{64}, size_t{4000}}}) {
+        RunGraph("corridor " + std::to_string(width) + "x" + std::to_string(length),
+                 width * length + 2, GenCorridor(width, length));
+    }
+    for (auto [length, fan] : {std::pair{size_t{20000}, size_t{20000}},
+                               std::pair{size_t{100000}, size_t{5000}}}) {
+        RunGraph("shared corridor " + std::to_string(length) + ", fan " + std::to_string(fan),
+                 length + fan + 2, GenSharedCorridor(length, fan));
+    }
+    RunGraph("uniform random, degree 8", size_t{1} << 18, GenRandomGraph(size_t{1} << 18, 8));
+    return 0;
+}
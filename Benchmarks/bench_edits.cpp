@@ -0,0 +1,67 @@
+#include "Kernel/max_flow.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<BasicEdge> GenRandomEdges(std::mt19937& gen, size_t n, size_t m) {
+    std::vector<BasicEdge> edges;
+    edges.reserve(m);
+    while (edges.size() < m) {
+        size_t u = gen() % n, to = gen() % n;
+        if (u != to) {
+            edges.push_back({u, to, gen() % 100 + 1});
+        }
+    }
+    return edges;
+}
+
+template <class Func>
+double Measure(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double MeasureEdits(MaxFlow& max_flow, std::mt19937& gen, size_t n,
+                    const std::vector<BasicEdge>& edges, size_t edits) {
+    return Measure([&]() {
+        for (size_t i = 0; i < edits; i++) {
+            size_t type = gen() % 5;
+            if (type < 2) {
+                max_flow.AddEdgeRequest(GenRandomEdges(gen, n, 1).front());
+            } else if (type < 4) {
+                max_flow.DeleteEdgeRequest(edges[gen() % edges.size()]);
+            } else {
+                max_flow.RecoverPrevStateRequest();
+            }
+        }
+    }) / edits;
+}
+}  // namespace
+
+int main() {
+    // Edits on a network without flow only touch the edge index and the undo log. After a
+    // solve, deleting an edge that carries flow also reroutes it, which may search the
+    // whole residual network.
+    const size_t solved_edits = 20000;
+    for (size_t m : {10000, 100000, 1000000}) {
+        std::mt19937 gen(m);
+        size_t n = m / 5;
+        auto edges = GenRandomEdges(gen, n, m);
+        MaxFlow max_flow(n, edges);
+        max_flow.SetTerminalsRequest(0, 1);
+        double time = MeasureEdits(max_flow, gen, n, edges, m);
+        MaxFlow solved_max_flow(n, edges);
+        solved_max_flow.SetTerminalsRequest(0, 1);
+        solved_max_flow.RunRequest();
+        double solved_time = MeasureEdits(solved_max_flow, gen, n, edges, solved_edits);
+        std::cout << "edges: " << m << ", " << m << " edits: " << time * 1e6
+                  << " us per edit, " << solved_edits << " edits after a solve: "
+                  << solved_time * 1e6 << " us per edit\n";
+    }
+    return 0;
+}
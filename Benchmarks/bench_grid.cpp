@@ -0,0 +1,86 @@
+#include "Kernel/max_flow.h"
+#include "Kernel/boykov_kolmogorov.h"
+#include "Kernel/push_relabel.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<BasicEdge> GenGrid(size_t width, size_t height, bool is_diagonal) {
+    std::mt19937 gen(239);
+    std::vector<BasicEdge> edges;
+    size_t n = width * height + 2;
+    for (size_t i = 0; i < width * height; i++) {
+        size_t weight = gen() % 100;
+        edges.push_back({0, i + 1, weight});
+        edges.push_back({i + 1, n - 1, 100 - weight});
+    }
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            size_t vertex = y * width + x + 1;
+            std::vector<size_t> neighbors;
+            if (x + 1 < width) {
+                neighbors.push_back(vertex + 1);
+            }
+            if (y + 1 < height) {
+                neighbors.push_back(vertex + width);
+            }
+            if (is_diagonal && x + 1 < width && y + 1 < height) {
+                neighbors.push_back(vertex + width + 1);
+            }
+            if (is_diagonal && x > 0 && y + 1 < height) {
+                neighbors.push_back(vertex + width - 1);
+            }
+            for (size_t to : neighbors) {
+                size_t weight = gen() % 30 + 1;
+                edges.push_back({vertex, to, weight});
+                edges.push_back({to, vertex, weight});
+            }
+        }
+    }
+    return edges;
+}
+
+template <class Func>
+double Measure(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RunGrid(size_t side, bool is_diagonal) {
+    auto edges = GenGrid(side, side, is_diagonal);
+    size_t n = side * side + 2;
+    std::cout << side << 'x' << side << (is_diagonal ? " 8" : " 4") << "-connected, "
+              << edges.size() << " edges\n";
+
+    size_t flow;
+    ResidualNetwork network(n, edges);
+    BoykovKolmogorov boykov_kolmogorov;
+    double time = Measure([&]() { flow = boykov_kolmogorov.Run(network, 0, n - 1); });
+    std::cout << "  boykov-kolmogorov: " << time << " s, flow " << flow << '\n';
+
+    network.Build(n, edges);
+    PushRelabel push_relabel;
+    time = Measure([&]() { flow = push_relabel.Run(network, 0, n - 1); });
+    std::cout << "  push-relabel:      " << time << " s, flow " << flow << '\n';
+
+    MaxFlow max_flow(n, edges);
+    time = Measure([&]() { max_flow.RunRequest(); });
+    flow = max_flow.GetMinCut().capacity;
+    std::cout << "  dinic:             " << time << " s, flow " << flow << '\n';
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t side = 512;
+    if (argc > 1) {
+        side = std::stoul(argv[1]);
+    }
+    RunGrid(side, false);
+    RunGrid(side, true);
+}
@@ -0,0 +1,103 @@
+#include "Kernel/dinic.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+using Edge = CapacityEdge<int64_t>;
+
+std::vector<Edge> GenRandomGraph(size_t n, size_t degree) {
+    std::mt19937_64 gen(239);
+    std::vector<Edge> edges;
+    for (size_t i = 0; i < n * degree; i++) {
+        size_t u = gen() % n, to = gen() % n;
+        if (u != to) {
+            edges.push_back({u, to, static_cast<int64_t>(gen() % 1000 + 1)});
+        }
+    }
+    return edges;
+}
+
+std::vector<Edge> GenPowerLawGraph(size_t scale, size_t degree) {
+    std::mt19937_64 gen(239);
+    std::uniform_real_distribution<double> distribution;
+    size_t n = size_t{1} << scale;
+    std::vector<Edge> edges;
+    for (size_t i = 0; i < n * degree; i++) {
+        size_t u = 0, to = 0;
+        for (size_t bit = 0; bit < scale; bit++) {
+            double p = distribution(gen);
+            u = (u << 1) | (p >= 0.57 + 0.19);
+            to = (to << 1) | (p >= 0.57 && p < 0.76) | (p >= 0.95);
+        }
+        if (u != to) {
+            edges.push_back({u, to, static_cast<int64_t>(gen() % 1000 + 1)});
+        }
+    }
+    return edges;
+}
+
+std::vector<Edge> GenGrid(size_t side) {
+    std::mt19937_64 gen(239);
+    std::vector<Edge> edges;
+    for (size_t y = 0; y < side; y++) {
+        for (size_t x = 0; x < side; x++) {
+            size_t vertex = y * side + x;
+            if (x + 1 < side) {
+                edges.push_back({vertex, vertex + 1, static_cast<int64_t>(gen() % 1000 + 1)});
+                edges.push_back({vertex + 1, vertex, static_cast<int64_t>(gen() % 1000 + 1)});
+            }
+            if (y + 1 < side) {
+                edges.push_back({vertex, vertex + side, static_cast<int64_t>(gen() % 1000 + 1)});
+                edges.push_back({vertex + side, vertex, static_cast<int64_t>(gen() % 1000 + 1)});
+            }
+        }
+    }
+    return edges;
+}
+
+template <class Func>
+double Measure(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RunGraph(const std::string& name, size_t n, const std::vector<Edge>& edges, size_t sink) {
+    std::cout << name << ", " << n << " vertices, " << edges.size() << " edges\n";
+    const std::vector<std::pair<LevelGraphBuilder, std::string>> builders = {
+        {LevelGraphBuilder::TopDown, "top-down:             "},
+        {LevelGraphBuilder::DirectionOptimizing, "direction-optimizing: "},
+        {LevelGraphBuilder::Parallel, "parallel:             "}};
+    for (const auto& [builder, builder_name] : builders) {
+        BasicResidualNetwork<int64_t> network(n, edges);
+        Dinic<int64_t> dinic(builder);
+        int64_t flow;
+        double time = Measure([&]() { flow = dinic.Run(network, 0, sink); });
+        const auto& statistics = dinic.GetStatistics();
+        std::cout << "  " << builder_name << time << " s (bfs " << statistics.level_graph_seconds
+                  << " s), flow " << flow << ", " << statistics.phases << " phases, "
+                  << statistics.inspected_arcs / std::max<size_t>(statistics.phases, 1)
+                  << " arcs per phase\n";
+    }
+}
+}  // namespace
+
+int main() {
+    for (size_t scale : {16, 18}) {
+        size_t n = size_t{1} << scale;
+        RunGraph("uniform random, degree 16", n, GenRandomGraph(n, 16), n - 1);
+        RunGraph("power-law, degree 16", n, GenPowerLawGraph(scale, 16), 1);
+    }
+    RunGraph("grid 256x256", 256 * 256, GenGrid(256), 256 * 256 - 1);
+    RunGraph("uniform random, degree 10", size_t{1} << 19, GenRandomGraph(size_t{1} << 19, 10),
+             (size_t{1} << 19) - 1);
+    std::cout << "threads: " << std::thread::hardware_concurrency() << '\n';
+    return 0;
+}
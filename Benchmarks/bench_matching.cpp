@@ -0,0 +1,65 @@
+#include "Kernel/dinic.h"
+#include "Kernel/max_flow.h"
+#include "Kernel/push_relabel.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<BasicEdge> GenMatchingNetwork(size_t side, size_t degree) {
+    std::mt19937_64 gen(239);
+    size_t sink = 2 * side + 1;
+    std::vector<BasicEdge> edges;
+    for (size_t i = 0; i < side; i++) {
+        edges.push_back({0, i + 1, 1});
+        edges.push_back({side + i + 1, sink, 1});
+    }
+    for (size_t i = 0; i < side; i++) {
+        for (size_t j = 0; j < degree; j++) {
+            edges.push_back({i + 1, side + (i + gen() % (4 * degree)) % side + 1, 1});
+        }
+    }
+    return edges;
+}
+
+template <class Func>
+double Measure(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RunNetwork(size_t side, size_t degree) {
+    auto edges = GenMatchingNetwork(side, degree);
+    size_t n = 2 * side + 2, sink = n - 1;
+    std::cout << "matching " << side << "x" << side << ", degree " << degree << ", "
+              << edges.size() << " edges\n";
+    size_t flow = 0;
+    MaxFlow max_flow(n, edges);
+    double time = Measure([&]() {
+        max_flow.RunRequest();
+        flow = max_flow.GetMinCut().capacity;
+    });
+    std::cout << "  MaxFlow (Hopcroft-Karp):  " << time << " s, flow " << flow << '\n';
+    ResidualNetwork dinic_network(n, edges);
+    Dinic<size_t> dinic;
+    time = Measure([&]() { flow = dinic.Run(dinic_network, 0, sink); });
+    std::cout << "  Dinic:                    " << time << " s, flow " << flow << '\n';
+    ResidualNetwork push_relabel_network(n, edges);
+    PushRelabel push_relabel;
+    time = Measure([&]() { flow = push_relabel.Run(push_relabel_network, 0, sink); });
+    std::cout << "  push-relabel:             " << time << " s, flow " << flow << '\n';
+}
+}  // namespace
+
+int main() {
+    for (size_t side : {1 << 14, 1 << 17}) {
+        RunNetwork(side, 3);
+        RunNetwork(side, 8);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "Kernel/push_relabel.h"
+#include "Kernel/parallel_push_relabel.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<BasicEdge> GenLayeredNetwork(size_t layers, size_t width, size_t degree,
+                                         size_t max_capacity) {
+    std::mt19937 gen(239);
+    size_t n = layers * width + 2;
+    std::vector<BasicEdge> edges;
+    for (size_t i = 0; i < width; i++) {
+        edges.push_back({0, i + 1, max_capacity * degree});
+        edges.push_back({(layers - 1) * width + i + 1, n - 1, max_capacity * degree});
+    }
+    for (size_t layer = 0; layer + 1 < layers; layer++) {
+        for (size_t i = 0; i < width; i++) {
+            for (size_t j = 0; j < degree; j++) {
+                edges.push_back({layer * width + i + 1, (layer + 1) * width + gen() % width + 1,
+                                 gen() % max_capacity + 1});
+            }
+        }
+    }
+    return edges;
+}
+
+template <class Engine>
+double Measure(Engine& engine, size_t n, const std::vector<BasicEdge>& edges, size_t& flow) {
+    ResidualNetwork network(n, edges);
+    auto start = std::chrono::steady_clock::now();
+    flow = engine.Run(network, 0, n - 1);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    if (argc > 1) {
+        max_threads = std::stoul(argv[1]);
+    }
+    const size_t layers = 100, width = 2000, degree = 5;
+    auto edges = GenLayeredNetwork(layers, width, degree, 1000);
+    size_t n = layers * width + 2;
+    std::cout << "vertices: " << n << ", edges: " << edges.size() << '\n';
+
+    size_t expected_flow;
+    PushRelabel push_relabel;
+    double base = Measure(push_relabel, n, edges, expected_flow);
+    std::cout << "sequential: " << base << " s, flow " << expected_flow << '\n';
+    for (size_t threads = 1; threads <= max_threads; threads++) {
+        ParallelPushRelabel parallel_push_relabel(threads);
+        size_t flow;
+        double time = Measure(parallel_push_relabel, n, edges, flow);
+        std::cout << "threads " << threads << ": " << time << " s, speedup " << base / time
+                  << (flow == expected_flow ? "" : ", WRONG FLOW") << '\n';
+    }
+}
@@ -0,0 +1,117 @@
+#include "Kernel/boykov_kolmogorov.h"
+#include "Kernel/dinic.h"
+#include "Kernel/max_flow.h"
+#include "Kernel/network_reduction.h"
+#include "Kernel/push_relabel.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<BasicEdge> GenRoadNetwork(size_t junctions, size_t degree, size_t& n) {
+    std::mt19937_64 gen(239);
+    std::vector<BasicEdge> edges;
+    n = junctions;
+    for (size_t i = 0; i < junctions * degree; i++) {
+        size_t u = gen() % junctions, to = gen() % junctions;
+        size_t length = gen() % 4, capacity = gen() % 1000 + 1;
+        for (size_t j = 0; j < length; j++) {
+            edges.push_back({u, n, capacity + gen() % 100});
+            u = n++;
+        }
+        edges.push_back({u, to, capacity});
+    }
+    for (size_t i = 0; i < junctions; i++) {
+        size_t u = gen() % n;
+        edges.push_back({u, n++, gen() % 1000 + 1});
+    }
+    return edges;
+}
+
+std::vector<BasicEdge> GenNestedNetwork(size_t depth, size_t& n) {
+    std::mt19937_64 gen(239);
+    std::vector<BasicEdge> edges = {{0, 1, gen() % 100 + 1}};
+    for (size_t i = 1; i <= depth; i++) {
+        edges.push_back({2 * i, 2 * i + 1, gen() % 100 + 1});
+        edges.push_back({2 * i, 2 * i - 2, gen() % 100 + 1});
+        edges.push_back({2 * i - 1, 2 * i + 1, gen() % 100 + 1});
+    }
+    n = 2 * depth + 2;
+    return edges;
+}
+
+template <class Func>
+double Measure(Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Engine>
+void RunEngine(const std::string& name, size_t n, const std::vector<BasicEdge>& edges,
+               size_t sink, const NetworkReduction& reduction) {
+    size_t flow, reduced_flow;
+    ResidualNetwork network(n, edges);
+    Engine engine;
+    double time = Measure([&]() { flow = engine.Run(network, 0, sink); });
+    network.Build(reduction.GetVerticesNumber(), reduction.GetEdges());
+    double reduced_time = Measure([&]() {
+        reduced_flow = engine.Run(network, reduction.GetSource(), reduction.GetSink());
+    });
+    std::cout << "  " << name << time << " s raw, " << reduced_time << " s reduced, flow " << flow
+              << ' ' << reduced_flow << '\n';
+}
+
+void RunNetwork(size_t junctions, size_t degree) {
+    size_t n;
+    auto edges = GenRoadNetwork(junctions, degree, n);
+    size_t sink = junctions - 1;
+    std::cout << "road network, " << n << " vertices, " << edges.size() << " edges\n";
+    NetworkReduction reduction;
+    double time = Measure([&]() { reduction.Build(n, edges, 0, sink); });
+    std::cout << "  reduction:          " << time << " s, " << reduction.GetVerticesNumber()
+              << " vertices, " << reduction.GetEdges().size() << " edges\n";
+    RunEngine<PushRelabel>("push-relabel:       ", n, edges, sink, reduction);
+    RunEngine<BoykovKolmogorov>("boykov-kolmogorov:  ", n, edges, sink, reduction);
+    RunEngine<Dinic<size_t>>("dinic:              ", n, edges, sink, reduction);
+    MaxFlow max_flow(n, edges);
+    max_flow.SetTerminalsRequest(0, sink);
+    time = Measure([&]() { max_flow.RunRequest(Engine::PushRelabel); });
+    std::cout << "  MaxFlow push-relabel: " << time << " s, flow "
+              << max_flow.GetMinCut().capacity << '\n';
+}
+
+void RunNestedNetwork(size_t depth) {
+    size_t n;
+    auto edges = GenNestedNetwork(depth, n);
+    std::cout << "nested series-parallel network, depth " << depth << ", " << edges.size()
+              << " edges\n";
+    NetworkReduction reduction;
+    double time = Measure([&]() { reduction.Build(n, edges, n - 2, n - 1); });
+    std::cout << "  reduction:          " << time << " s, " << reduction.GetEdges().size()
+              << " edges\n";
+    ResidualNetwork network(n, edges);
+    PushRelabel push_relabel;
+    size_t flow;
+    time = Measure([&]() { flow = push_relabel.Run(network, n - 2, n - 1); });
+    std::cout << "  push-relabel:       " << time << " s raw, flow " << flow << '\n';
+    MaxFlow max_flow(n, edges);
+    max_flow.SetTerminalsRequest(n - 2, n - 1);
+    time = Measure([&]() { max_flow.RunRequest(Engine::PushRelabel); });
+    std::cout << "  MaxFlow push-relabel: " << time << " s, flow "
+              << max_flow.GetMinCut().capacity << '\n';
+}
+}  // namespace
+
+int main() {
+    RunNetwork(1 << 16, 3);
+    RunNetwork(1 << 19, 3);
+    for (size_t depth : {1000, 4000, 16000, 64000}) {
+        RunNestedNetwork(depth);
+    }
+    return 0;
+}
@@ -9,7 +9,8 @@ GeomModel::GeomModel() : timer_(new QTimer(this)) {
 }
 
 void GeomModel::RegisterView(StateObserver* observer) {
-    assert(geom_model_observable_.Subscribe(observer));
+    [[maybe_unused]] bool is_subscribed = geom_model_observable_.Subscribe(observer);
+    assert(is_subscribed);
     StartTimer();
 }
 
@@ -30,6 +31,7 @@ GeomModel::UnlockObserver* GeomModel::GetUnlockObserverPtr() {
 }
 
 void GeomModel::ProcessNextState() {
+    ReceiveModelEvents();
     if (states_.empty() && selected_vertex_ == std::string::npos) {
         return;
     }
@@ -37,14 +39,40 @@ void GeomModel::ProcessNextState() {
     geom_model_observable_.Notify();
 }
 
+void GeomModel::ReceiveModelEvents(bool is_draining) {
+    while (is_draining || is_skipping_ || states_.empty()) {
+        auto event = model_events_.TryPop();
+        if (!event) {
+            return;
+        }
+        if (event->is_cleanup) {
+            SkipFrames();
+            continue;
+        }
+        bool is_unlock = event->state.is_unlock;
+        states_.push_back(std::move(event->state));
+        if (is_draining || is_skipping_) {
+            SkipFrames();
+        }
+        if (is_unlock && scheduled_solves_) {
+            scheduled_solves_--;
+            is_skipping_ = false;
+            is_dropping_dynamic_states_ = false;
+        }
+    }
+}
+
 void GeomModel::AddDynamicState(const MaxFlowData& data) {
+    if (is_dropping_dynamic_states_) {
+        return;
+    }
     GeomModelData geom_model{.edges = data.edges,
                              .vertices = data.vertices,
                              .edge_id = data.updated_edge,
                              .frame_id = 0,
                              .flow_rate = data.flow_rate,
                              .pushed_flow = data.pushed_flow};
-    states_.push_back({.geom_model = std::move(geom_model)});
+    model_events_.Push({.state = {.geom_model = std::move(geom_model)}}, frames_stop_token_);
 }
 
 void GeomModel::AddStaticState(const MaxFlowData& data) {
@@ -53,11 +81,15 @@ void GeomModel::AddStaticState(const MaxFlowData& data) {
                              .edge_id = std::string::npos,
                              .flow_rate = data.flow_rate,
                              .pushed_flow = data.pushed_flow};
-    states_.push_back({.geom_model = std::move(geom_model)});
+    model_events_.Push({.state = {.geom_model = std::move(geom_model)}});
 }
 
 void GeomModel::AddUnlockNotification() {
-    states_.push_back({.is_unlock = true});
+    model_events_.Push({.state = {.is_unlock = true}});
+}
+
+void GeomModel::AddCleanupNotification() {
+    model_events_.Push({.is_cleanup = true});
 }
 
 void GeomModel::StartTimer() {
@@ -77,8 +109,26 @@ void GeomModel::SkipFrames() {
 }
 
 void GeomModel::SkipFramesRequest() {
+    ReceiveModelEvents(true);
     SkipFrames();
-    AddUnlockNotification();
+    if (scheduled_solves_) {
+        is_skipping_ = true;
+        is_dropping_dynamic_states_ = true;
+        return;
+    }
+    states_.push_back({.is_unlock = true});
+}
+
+void GeomModel::SolveScheduledRequest() {
+    scheduled_solves_++;
+}
+
+void GeomModel::SetFramesStopToken(std::stop_token stop_token) {
+    frames_stop_token_ = std::move(stop_token);
+}
+
+void GeomModel::CloseModelEventsRequest() {
+    model_events_.Close();
 }
 
 void GeomModel::ChangeSpeedRequest(size_t slider_pos) {
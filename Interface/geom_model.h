@@ -1,10 +1,13 @@
 #ifndef STATUSMANAGER_H
 #define STATUSMANAGER_H
+#include <atomic>
 #include <memory>
 #include <QTimer>
 #include <deque>
+#include <stop_token>
 #include "Kernel/kernel_messages.h"
 #include "interface_messages.h"
+#include "Library/channel.h"
 #include "Library/observer_pattern.h"
 
 namespace max_flow_app {
@@ -28,6 +31,9 @@ public:
     ClearSignalObserver* GetClearSignalObserverPtr();
     UnlockObserver* GetUnlockObserverPtr();
     void SkipFramesRequest();
+    void SolveScheduledRequest();
+    void SetFramesStopToken(std::stop_token stop_token);
+    void CloseModelEventsRequest();
     void ChangeSpeedRequest(size_t slider_pos);
     void ChangeLatencyRequest(size_t slider_pos);
     static size_t GetFPSRate();
@@ -42,10 +48,17 @@ private:
     using GeomModelData = interface_messages::GeomModelData;
     using StateObservable = observer_pattern::Observable<FrameQueueData>;
 
+    struct ModelEvent {
+        FrameQueueData state;
+        bool is_cleanup = false;
+    };
+
+    void ReceiveModelEvents(bool is_draining = false);
     void SkipFrames();
     void AddDynamicState(const MaxFlowData& data);
     void AddStaticState(const MaxFlowData& data);
     void AddUnlockNotification();
+    void AddCleanupNotification();
     void StartTimer();
     void ResetPos(size_t n);
     const FrameQueueData& SendFrameToView();
@@ -60,6 +73,7 @@ private:
     static constexpr size_t kTimerInterval = 1000 / kFPSRate;
     static constexpr size_t kBasicSpeed = kFPSRate;
     static constexpr size_t kBasicLatency = kFPSRate;
+    static constexpr size_t kModelEventsLookahead = 64;
     inline static const std::vector<double> kSpeedCoef = {7.0, 3.0, 2.5, 2.0, 1.5, 1.0,
                                                    0.75, 0.5, 0.33, 0.25, 0.166};
     inline static const std::vector<double> kLatencyCoef = {3.0, 2.0, 1.5, 1.0, 0.75, 0.5, 0.3};
@@ -67,6 +81,14 @@ private:
     size_t latency_ = kBasicLatency;
     std::unique_ptr<QTimer> timer_;
     std::deque<FrameQueueData> states_;
+    channel::Channel<ModelEvent> model_events_ =
+        channel::Channel<ModelEvent>(kModelEventsLookahead);
+    size_t scheduled_solves_ = 0;
+    bool is_skipping_ = false;
+    std::atomic<bool> is_dropping_dynamic_states_ = false;
+    // Set by the worker before each solve, so a stopped solve drops its dynamic frames instead of
+    // waiting for a free slot. Only touched by the worker thread.
+    std::stop_token frames_stop_token_;
     FrameQueueData message_;
     NetworkObserver network_observer_ = NetworkObserver(
         [this](const MaxFlowData& data) { AddStaticState(data); },
@@ -77,7 +99,7 @@ private:
     UnlockObserver unlock_observer_ =
         ClearSignalObserver([]() {}, [this]() { AddUnlockNotification(); }, []() {});
     ClearSignalObserver clear_signal_observer_ =
-        ClearSignalObserver([]() {}, [this]() { SkipFrames(); }, []() {});
+        ClearSignalObserver([]() {}, [this]() { AddCleanupNotification(); }, []() {});
     StateObservable geom_model_observable_ =
         StateObservable([this]() -> const FrameQueueData& { return SendFrameToView(); });
     std::vector<QPointF> pos_;
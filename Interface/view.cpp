@@ -136,7 +136,8 @@ const View::CommandData& View::ProduceViewMessage() const {
 }
 
 void View::RegisterController(CommandObserver* observer) {
-    assert(command_observable_.Subscribe(observer));
+    [[maybe_unused]] bool is_subscribed = command_observable_.Subscribe(observer);
+    assert(is_subscribed);
 }
 
 void View::LockInterface() {
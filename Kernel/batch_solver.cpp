@@ -0,0 +1,48 @@
+#include "batch_solver.h"
+#include <cassert>
+#include <string>
+
+namespace max_flow_app {
+BatchSolver::BatchSolver(size_t threads_number)
+    : pool_(threads_number), workspaces_(pool_.GetThreadsNumber()) {
+}
+
+size_t BatchSolver::GetThreadsNumber() const {
+    return pool_.GetThreadsNumber();
+}
+
+std::vector<BatchSolver::Result> BatchSolver::Solve(std::span<const Instance> instances,
+                                                    bool with_edge_flows) {
+    std::vector<Result> results(instances.size());
+    pool_.ParallelFor(
+        instances.size(),
+        [&](size_t index, size_t thread_id) {
+            SolveInstance(instances[index], with_edge_flows, workspaces_[thread_id],
+                          results[index]);
+        },
+        kGrain);
+    return results;
+}
+
+void BatchSolver::SolveInstance(const Instance& instance, bool with_edge_flows,
+                                Workspace& workspace, Result& result) {
+    size_t sink = instance.sink == std::string::npos ? instance.n - 1 : instance.sink;
+    if (!instance.n || instance.source == sink) {
+        result.flow = 0;
+        if (with_edge_flows) {
+            result.edge_flows.assign(instance.edges.size(), 0);
+        }
+        return;
+    }
+    assert(instance.source < instance.n && sink < instance.n);
+    workspace.network.Build(instance.n, instance.edges);
+    result.flow = workspace.dinic.Run(workspace.network, instance.source, sink);
+    if (!with_edge_flows) {
+        return;
+    }
+    result.edge_flows.resize(instance.edges.size());
+    for (size_t i = 0; i < instance.edges.size(); i++) {
+        result.edge_flows[i] = workspace.network.GetFlow(i);
+    }
+}
+}  // namespace max_flow_app
@@ -0,0 +1,37 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <vector>
+#include "Library/thread_pool.h"
+#include "dinic.h"
+#include "kernel_messages.h"
+#include "residual_network.h"
+
+namespace max_flow_app {
+class BatchSolver {
+public:
+    using Instance = kernel_messages::FlowInstance;
+    using Result = kernel_messages::FlowResult;
+
+    explicit BatchSolver(size_t threads_number = std::thread::hardware_concurrency());
+
+    std::vector<Result> Solve(std::span<const Instance> instances, bool with_edge_flows = false);
+    size_t GetThreadsNumber() const;
+
+private:
+    struct Workspace {
+        ResidualNetwork network;
+        Dinic<size_t> dinic;
+    };
+
+    void SolveInstance(const Instance& instance, bool with_edge_flows, Workspace& workspace,
+                       Result& result);
+
+    static constexpr size_t kGrain = 16;
+    thread_pool::ThreadPool pool_;
+    std::vector<Workspace> workspaces_;
+};
+}  // namespace max_flow_app
+#endif  // BATCH_SOLVER_H
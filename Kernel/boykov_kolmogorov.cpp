@@ -0,0 +1,194 @@
+#include "boykov_kolmogorov.h"
+#include <algorithm>
+#include <cassert>
+
+namespace max_flow_app {
+size_t BoykovKolmogorov::Run(ResidualNetwork& network, size_t source, size_t sink) {
+    assert(source != sink);
+    Init(network.GetVerticesNumber(), source, sink);
+    size_t flow = 0;
+    while (!active_.empty()) {
+        size_t vertex = active_.front();
+        size_t index = trees_[vertex] == Tree::Free ? kNoParent : Grow(network, vertex);
+        if (index == kNoParent) {
+            active_.pop_front();
+            is_active_[vertex] = false;
+            continue;
+        }
+        time_++;
+        flow += Augment(network, vertex, index);
+        Adopt(network);
+    }
+    return flow;
+}
+
+void BoykovKolmogorov::Init(size_t n, size_t source, size_t sink) {
+    trees_.assign(n, Tree::Free);
+    parents_.assign(n, kNoParent);
+    timestamps_.assign(n, 0);
+    distances_.assign(n, 0);
+    processed_neighbors_.assign(n, 0);
+    is_active_.assign(n, false);
+    active_.clear();
+    orphans_.clear();
+    time_ = 0;
+    trees_[source] = Tree::Source;
+    trees_[sink] = Tree::Sink;
+    parents_[source] = parents_[sink] = kTerminal;
+    Activate(source);
+    Activate(sink);
+}
+
+size_t BoykovKolmogorov::Grow(const ResidualNetwork& network, size_t vertex) {
+    Tree tree = trees_[vertex];
+    for (size_t& processed = processed_neighbors_[vertex];
+         network.Begin(vertex) + processed < network.End(vertex); processed++) {
+        size_t i = network.Begin(vertex) + processed;
+        if (!GetResidual(network, i, tree)) {
+            continue;
+        }
+        size_t to = network.GetHead(i);
+        if (trees_[to] == Tree::Free) {
+            trees_[to] = tree;
+            parents_[to] = network.GetReverse(i);
+            timestamps_[to] = timestamps_[vertex];
+            distances_[to] = distances_[vertex] + 1;
+            Activate(to);
+        } else if (trees_[to] != tree) {
+            return i;
+        } else if (parents_[to] != kTerminal && timestamps_[to] <= timestamps_[vertex] &&
+                   distances_[to] > distances_[vertex]) {
+            parents_[to] = network.GetReverse(i);
+            timestamps_[to] = timestamps_[vertex];
+            distances_[to] = distances_[vertex] + 1;
+        }
+    }
+    return kNoParent;
+}
+
+size_t BoykovKolmogorov::Augment(ResidualNetwork& network, size_t vertex, size_t index) {
+    size_t source_end = vertex, sink_end = network.GetHead(index);
+    size_t middle = index;
+    if (trees_[vertex] == Tree::Sink) {
+        std::swap(source_end, sink_end);
+        middle = network.GetReverse(index);
+    }
+    size_t flow = network.GetResidual(middle);
+    for (size_t cur = source_end; parents_[cur] != kTerminal;) {
+        flow = std::min(flow, network.GetResidual(network.GetReverse(parents_[cur])));
+        cur = network.GetHead(parents_[cur]);
+    }
+    for (size_t cur = sink_end; parents_[cur] != kTerminal;) {
+        flow = std::min(flow, network.GetResidual(parents_[cur]));
+        cur = network.GetHead(parents_[cur]);
+    }
+    network.Push(middle, flow);
+    for (size_t cur = source_end; parents_[cur] != kTerminal;) {
+        size_t next = network.GetHead(parents_[cur]);
+        size_t reverse = network.GetReverse(parents_[cur]);
+        network.Push(reverse, flow);
+        if (!network.GetResidual(reverse)) {
+            MakeOrphan(cur);
+        }
+        cur = next;
+    }
+    for (size_t cur = sink_end; parents_[cur] != kTerminal;) {
+        size_t next = network.GetHead(parents_[cur]);
+        network.Push(parents_[cur], flow);
+        if (!network.GetResidual(parents_[cur])) {
+            MakeOrphan(cur);
+        }
+        cur = next;
+    }
+    return flow;
+}
+
+void BoykovKolmogorov::Adopt(const ResidualNetwork& network) {
+    while (!orphans_.empty()) {
+        size_t vertex = orphans_.front();
+        orphans_.pop_front();
+        ProcessOrphan(network, vertex);
+    }
+}
+
+void BoykovKolmogorov::ProcessOrphan(const ResidualNetwork& network, size_t vertex) {
+    Tree tree = trees_[vertex];
+    size_t best_parent = kNoParent, best_distance = kInfiniteDistance;
+    for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+        size_t to = network.GetHead(i);
+        if (trees_[to] != tree || parents_[to] == kNoParent ||
+            !GetResidual(network, network.GetReverse(i), tree)) {
+            continue;
+        }
+        size_t distance = GetOriginDistance(network, to);
+        if (distance < best_distance) {
+            best_parent = i;
+            best_distance = distance;
+        }
+    }
+    if (best_parent != kNoParent) {
+        parents_[vertex] = best_parent;
+        timestamps_[vertex] = time_;
+        distances_[vertex] = best_distance + 1;
+        return;
+    }
+    for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+        size_t to = network.GetHead(i);
+        if (trees_[to] != tree) {
+            continue;
+        }
+        if (GetResidual(network, network.GetReverse(i), tree)) {
+            Activate(to);
+        }
+        if (parents_[to] != kNoParent && parents_[to] != kTerminal &&
+            network.GetHead(parents_[to]) == vertex) {
+            MakeOrphan(to);
+        }
+    }
+    trees_[vertex] = Tree::Free;
+}
+
+size_t BoykovKolmogorov::GetOriginDistance(const ResidualNetwork& network, size_t vertex) {
+    size_t distance = 0;
+    for (size_t cur = vertex;; distance++) {
+        if (timestamps_[cur] == time_) {
+            distance += distances_[cur];
+            break;
+        }
+        if (parents_[cur] == kTerminal) {
+            timestamps_[cur] = time_;
+            distances_[cur] = 0;
+            break;
+        }
+        if (parents_[cur] == kNoParent) {
+            return kInfiniteDistance;
+        }
+        cur = network.GetHead(parents_[cur]);
+    }
+    size_t result = distance;
+    for (size_t cur = vertex; timestamps_[cur] != time_; cur = network.GetHead(parents_[cur])) {
+        timestamps_[cur] = time_;
+        distances_[cur] = distance--;
+    }
+    return result;
+}
+
+size_t BoykovKolmogorov::GetResidual(const ResidualNetwork& network, size_t index,
+                                     Tree tree) const {
+    return tree == Tree::Source ? network.GetResidual(index)
+                                : network.GetResidual(network.GetReverse(index));
+}
+
+void BoykovKolmogorov::Activate(size_t vertex) {
+    processed_neighbors_[vertex] = 0;
+    if (!is_active_[vertex]) {
+        is_active_[vertex] = true;
+        active_.push_back(vertex);
+    }
+}
+
+void BoykovKolmogorov::MakeOrphan(size_t vertex) {
+    parents_[vertex] = kNoParent;
+    orphans_.push_back(vertex);
+}
+}  // namespace max_flow_app
@@ -0,0 +1,41 @@
+#ifndef BOYKOV_KOLMOGOROV_H
+#define BOYKOV_KOLMOGOROV_H
+#include <deque>
+#include <vector>
+#include <cstddef>
+#include <string>
+#include "residual_network.h"
+
+namespace max_flow_app {
+class BoykovKolmogorov {
+public:
+    size_t Run(ResidualNetwork& network, size_t source, size_t sink);
+
+private:
+    enum class Tree : unsigned char { Free, Source, Sink };
+
+    void Init(size_t n, size_t source, size_t sink);
+    size_t Grow(const ResidualNetwork& network, size_t vertex);
+    size_t Augment(ResidualNetwork& network, size_t vertex, size_t index);
+    void Adopt(const ResidualNetwork& network);
+    void ProcessOrphan(const ResidualNetwork& network, size_t vertex);
+    size_t GetOriginDistance(const ResidualNetwork& network, size_t vertex);
+    size_t GetResidual(const ResidualNetwork& network, size_t index, Tree tree) const;
+    void Activate(size_t vertex);
+    void MakeOrphan(size_t vertex);
+
+    static constexpr size_t kNoParent = std::string::npos;
+    static constexpr size_t kTerminal = std::string::npos - 1;
+    static constexpr size_t kInfiniteDistance = std::string::npos;
+    std::vector<Tree> trees_;
+    std::vector<size_t> parents_;
+    std::vector<size_t> timestamps_;
+    std::vector<size_t> distances_;
+    std::vector<size_t> processed_neighbors_;
+    std::vector<bool> is_active_;
+    std::deque<size_t> active_;
+    std::deque<size_t> orphans_;
+    size_t time_ = 0;
+};
+}  // namespace max_flow_app
+#endif  // BOYKOV_KOLMOGOROV_H
@@ -6,31 +6,65 @@ Controller::Controller(MaxFlow* model_ptr, GeomModel* geom_model_ptr)
       geom_model_ptr_(geom_model_ptr),
       view_observer_([](const CommandData&) {},
                      [this](const CommandData& data) { HandleData(data); },
-                     [](const CommandData&) {}) {
+                     [](const CommandData&) {}),
+      model_worker_([this](std::stop_token stop_token) { ProcessModelRequests(stop_token); }) {
+}
+
+Controller::~Controller() {
+    model_worker_.request_stop();
+    model_requests_.Close();
+    geom_model_ptr_->CloseModelEventsRequest();
+    // Joined here rather than by member destruction, so the worker never outlives the channels.
+    model_worker_.join();
+}
+
+void Controller::PostModelRequest(ModelRequest request) {
+    model_requests_.Push(std::move(request));
+}
+
+void Controller::ProcessModelRequests(std::stop_token stop_token) {
+    while (auto request = model_requests_.Pop()) {
+        if (stop_token.stop_requested()) {
+            return;
+        }
+        (*request)(stop_token);
+    }
 }
 
 void Controller::CallChangeVerticesNumber(size_t new_number) {
-    model_ptr_->ChangeVerticesNumberRequest(new_number);
+    PostModelRequest([this, new_number](std::stop_token) {
+        model_ptr_->ChangeVerticesNumberRequest(new_number);
+    });
 }
 
 void Controller::CallAddEdge(const MaxFlow::BasicEdge& edge) {
-    model_ptr_->AddEdgeRequest(edge);
+    PostModelRequest([this, edge](std::stop_token) { model_ptr_->AddEdgeRequest(edge); });
 }
 
 void Controller::CallDeleteEdge(const MaxFlow::BasicEdge& edge) {
-    model_ptr_->DeleteEdgeRequest(edge);
+    PostModelRequest([this, edge](std::stop_token) { model_ptr_->DeleteEdgeRequest(edge); });
 }
 
 void Controller::CallRun() {
-    model_ptr_->RunRequest();
+    solve_stop_source_ = std::stop_source();
+    geom_model_ptr_->SolveScheduledRequest();
+    PostModelRequest([this, solve_stop_source = solve_stop_source_](
+                         std::stop_token stop_token) mutable {
+        std::stop_callback stop_solve(stop_token,
+                                      [&solve_stop_source]() { solve_stop_source.request_stop(); });
+        geom_model_ptr_->SetFramesStopToken(solve_stop_source.get_token());
+        model_ptr_->SolveRequest(solve_stop_source.get_token());
+    });
 }
 
 void Controller::CallGenRandomSample() {
-    model_ptr_->GenRandomSampleRequest();
+    PostModelRequest([this](std::stop_token) { model_ptr_->GenRandomSampleRequest(); });
 }
 
 void Controller::CallCancel() {
-    model_ptr_->RecoverPrevStateRequest();
+    solve_stop_source_.request_stop();
+    geom_model_ptr_->SkipFramesRequest();
+    PostModelRequest([this](std::stop_token) { model_ptr_->RecoverPrevStateRequest(); });
 }
 
 void Controller::CallSkip() {
@@ -1,6 +1,10 @@
 #ifndef CONTROLLER_H
 #define CONTROLLER_H
 
+#include <functional>
+#include <stop_token>
+#include <thread>
+#include "Library/channel.h"
 #include "Library/observer_pattern.h"
 #include "max_flow.h"
 #include "Interface/geom_model.h"
@@ -12,12 +16,18 @@ public:
     using ViewObserver = observer_pattern::Observer<CommandData>;
 
     Controller(MaxFlow* model_ptr, GeomModel* geom_model_ptr);
+    Controller(const Controller&) = delete;
+    Controller(Controller&&) = delete;
+    Controller& operator=(const Controller&) = delete;
+    Controller& operator=(Controller&&) = delete;
+    ~Controller();
 
     ViewObserver* GetSubscriberPtr();
 
 private:
     using BasicEdge = kernel_messages::BasicEdge;
     using MousePosition = interface_messages::MousePosition;
+    using ModelRequest = std::function<void(std::stop_token)>;
 
     void CallChangeVerticesNumber(size_t new_number);
     void CallAddEdge(const BasicEdge& edge);
@@ -32,10 +42,15 @@ private:
     void CallChangeSpeed(size_t slider_pos);
     void CallChangeLatency(size_t slider_pos);
     void HandleData(const CommandData& data);
+    void PostModelRequest(ModelRequest request);
+    void ProcessModelRequests(std::stop_token stop_token);
 
     MaxFlow* model_ptr_;
     GeomModel* geom_model_ptr_;
     ViewObserver view_observer_;
+    std::stop_source solve_stop_source_;
+    channel::Channel<ModelRequest> model_requests_;
+    std::jthread model_worker_;
 };
 }  // namespace max_flow_app
 
@@ -0,0 +1,375 @@
+#include "dinic.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <tuple>
+#include <type_traits>
+
+namespace max_flow_app {
+template <class Capacity>
+CapacityScaling<Capacity>::CapacityScaling(Capacity max_capacity) {
+    if constexpr (std::is_integral_v<Capacity>) {
+        using Unsigned = std::make_unsigned_t<Capacity>;
+        threshold_ = static_cast<Capacity>(std::bit_floor(static_cast<Unsigned>(max_capacity)));
+    } else {
+        threshold_ = max_capacity;
+        epsilon_ = max_capacity * kRelativeEpsilon;
+    }
+}
+
+template <class Capacity>
+Capacity CapacityScaling<Capacity>::GetThreshold() const {
+    return threshold_;
+}
+
+template <class Capacity>
+bool CapacityScaling<Capacity>::IsResidual(Capacity capacity) const {
+    return capacity > epsilon_;
+}
+
+template <class Capacity>
+bool CapacityScaling<Capacity>::Next() {
+    if constexpr (std::is_integral_v<Capacity>) {
+        threshold_ >>= 1;
+        return threshold_ > 0;
+    } else {
+        if (threshold_ <= epsilon_) {
+            return false;
+        }
+        threshold_ = std::max(threshold_ / 2, epsilon_);
+        return true;
+    }
+}
+
+template <class Capacity>
+Dinic<Capacity>::Dinic(LevelGraphBuilder builder, size_t threads_number) : builder_(builder) {
+    if (builder_ == LevelGraphBuilder::Parallel) {
+        pool_ = std::make_unique<thread_pool::ThreadPool>(threads_number);
+        thread_frontiers_.resize(pool_->GetThreadsNumber());
+        thread_inspected_arcs_.resize(pool_->GetThreadsNumber());
+    }
+}
+
+template <class Capacity>
+Dinic<Capacity>::Dinic(BlockingFlow blocking_flow, LevelGraphBuilder builder,
+                       size_t threads_number)
+    : Dinic(builder, threads_number) {
+    blocking_flow_ = blocking_flow;
+}
+
+template <class Capacity>
+const typename Dinic<Capacity>::Statistics& Dinic<Capacity>::GetStatistics() const {
+    return statistics_;
+}
+
+template <class Capacity>
+typename Dinic<Capacity>::Flow Dinic<Capacity>::Run(Network& network, size_t source,
+                                                    size_t sink) {
+    assert(source != sink);
+    statistics_ = Statistics();
+    Capacity max_capacity = 0;
+    for (size_t i = 0; i < network.GetArcsNumber(); i++) {
+        if constexpr (std::is_signed_v<Capacity>) {
+            assert(network.GetResidual(i) >= 0);
+        }
+        max_capacity = std::max(max_capacity, network.GetResidual(i));
+    }
+    scaling_ = CapacityScaling<Capacity>(max_capacity);
+    Flow flow = 0;
+    if (!scaling_.IsResidual(max_capacity)) {
+        return flow;
+    }
+    do {
+        while (true) {
+            auto start = std::chrono::steady_clock::now();
+            bool is_reachable = BuildLevels(network, source, sink);
+            statistics_.level_graph_seconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (!is_reachable) {
+                break;
+            }
+            for (size_t vertex = 0; vertex < network.GetVerticesNumber(); vertex++) {
+                current_arcs_[vertex] = network.Begin(vertex);
+            }
+            if (blocking_flow_ == BlockingFlow::DynamicTrees) {
+                flow += FindBlockingFlow(network, source, sink);
+                continue;
+            }
+            size_t augmented_arcs = 0;
+            path_.clear();
+            while (FindPath(network, source, sink)) {
+                augmented_arcs += path_.size();
+                flow += Augment(network);
+                if (blocking_flow_ == BlockingFlow::Adaptive &&
+                    augmented_arcs > kAugmentedArcsFactor * network.GetArcsNumber()) {
+                    flow += FindBlockingFlow(network, source, sink);
+                    break;
+                }
+            }
+        }
+    } while (scaling_.Next());
+    return flow;
+}
+
+template <class Capacity>
+bool Dinic<Capacity>::BuildLevels(const Network& network, size_t source, size_t sink) {
+    size_t n = network.GetVerticesNumber();
+    levels_.assign(n, kNone);
+    current_arcs_.resize(n);
+    levels_[source] = 0;
+    statistics_.phases++;
+    switch (builder_) {
+        case LevelGraphBuilder::DirectionOptimizing:
+            return BuildLevelsDirectionOptimizing(network, source, sink);
+        case LevelGraphBuilder::Parallel:
+            return BuildLevelsParallel(network, source, sink);
+        default:
+            return BuildLevelsTopDown(network, source, sink);
+    }
+}
+
+template <class Capacity>
+bool Dinic<Capacity>::BuildLevelsTopDown(const Network& network, size_t source, size_t sink) {
+    queue_.assign(1, source);
+    for (size_t head = 0; head < queue_.size() && levels_[sink] == kNone; head++) {
+        size_t vertex = queue_[head];
+        statistics_.inspected_arcs += network.End(vertex) - network.Begin(vertex);
+        for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+            size_t to = network.GetHead(i);
+            if (levels_[to] == kNone && IsLevelArc(network.GetResidual(i))) {
+                levels_[to] = levels_[vertex] + 1;
+                queue_.push_back(to);
+            }
+        }
+    }
+    return levels_[sink] != kNone;
+}
+
+template <class Capacity>
+bool Dinic<Capacity>::BuildLevelsDirectionOptimizing(const Network& network, size_t source,
+                                                     size_t sink) {
+    size_t n = network.GetVerticesNumber();
+    size_t unexplored_arcs =
+        network.GetArcsNumber() - (network.End(source) - network.Begin(source));
+    bool is_bottom_up = false;
+    queue_.assign(1, source);
+    for (size_t level = 1; !queue_.empty() && levels_[sink] == kNone; level++) {
+        size_t frontier_arcs = 0;
+        for (size_t vertex : queue_) {
+            frontier_arcs += network.End(vertex) - network.Begin(vertex);
+        }
+        if (!is_bottom_up && frontier_arcs > unexplored_arcs / kTopDownFactor) {
+            is_bottom_up = true;
+        } else if (is_bottom_up && queue_.size() < n / kBottomUpFactor) {
+            is_bottom_up = false;
+        }
+        next_queue_.clear();
+        if (is_bottom_up) {
+            StepBottomUp(network, level);
+        } else {
+            StepTopDown(network, level);
+        }
+        for (size_t vertex : next_queue_) {
+            unexplored_arcs -= network.End(vertex) - network.Begin(vertex);
+        }
+        queue_.swap(next_queue_);
+    }
+    return levels_[sink] != kNone;
+}
+
+template <class Capacity>
+bool Dinic<Capacity>::BuildLevelsParallel(const Network& network, size_t source, size_t sink) {
+    queue_.assign(1, source);
+    for (size_t level = 1; !queue_.empty() && levels_[sink] == kNone; level++) {
+        pool_->ParallelFor(
+            queue_.size(),
+            [&](size_t index, size_t thread_id) {
+                size_t vertex = queue_[index];
+                thread_inspected_arcs_[thread_id] += network.End(vertex) - network.Begin(vertex);
+                for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+                    size_t to = network.GetHead(i);
+                    std::atomic_ref<size_t> to_level(levels_[to]);
+                    size_t expected = kNone;
+                    if (to_level.load(std::memory_order_relaxed) == kNone &&
+                        IsLevelArc(network.GetResidual(i)) &&
+                        to_level.compare_exchange_strong(expected, level,
+                                                         std::memory_order_relaxed)) {
+                        thread_frontiers_[thread_id].push_back(to);
+                    }
+                }
+            },
+            kGrain);
+        queue_.clear();
+        for (auto& frontier : thread_frontiers_) {
+            queue_.insert(queue_.end(), frontier.begin(), frontier.end());
+            frontier.clear();
+        }
+    }
+    for (size_t& inspected_arcs : thread_inspected_arcs_) {
+        statistics_.inspected_arcs += inspected_arcs;
+        inspected_arcs = 0;
+    }
+    return levels_[sink] != kNone;
+}
+
+template <class Capacity>
+void Dinic<Capacity>::StepTopDown(const Network& network, size_t level) {
+    for (size_t vertex : queue_) {
+        statistics_.inspected_arcs += network.End(vertex) - network.Begin(vertex);
+        for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+            size_t to = network.GetHead(i);
+            if (levels_[to] == kNone && IsLevelArc(network.GetResidual(i))) {
+                levels_[to] = level;
+                next_queue_.push_back(to);
+            }
+        }
+    }
+}
+
+template <class Capacity>
+void Dinic<Capacity>::StepBottomUp(const Network& network, size_t level) {
+    frontier_.Assign(network.GetVerticesNumber());
+    for (size_t vertex : queue_) {
+        frontier_.Set(vertex);
+    }
+    for (size_t vertex = 0; vertex < network.GetVerticesNumber(); vertex++) {
+        if (levels_[vertex] != kNone) {
+            continue;
+        }
+        for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+            statistics_.inspected_arcs++;
+            if (frontier_.Test(network.GetHead(i)) &&
+                IsLevelArc(network.GetResidual(network.GetReverse(i)))) {
+                levels_[vertex] = level;
+                next_queue_.push_back(vertex);
+                break;
+            }
+        }
+    }
+}
+
+template <class Capacity>
+bool Dinic<Capacity>::IsLevelArc(Capacity residual) const {
+    return residual >= scaling_.GetThreshold() && scaling_.IsResidual(residual);
+}
+
+template <class Capacity>
+bool Dinic<Capacity>::IsAdmissible(const Network& network, size_t index, size_t vertex) const {
+    return IsLevelArc(network.GetResidual(index)) &&
+           levels_[network.GetHead(index)] == levels_[vertex] + 1;
+}
+
+template <class Capacity>
+bool Dinic<Capacity>::FindPath(const Network& network, size_t source, size_t sink) {
+    while (true) {
+        size_t vertex = path_.empty() ? source : network.GetHead(path_.back());
+        if (vertex == sink) {
+            return true;
+        }
+        size_t& current = current_arcs_[vertex];
+        while (current < network.End(vertex) && !IsAdmissible(network, current, vertex)) {
+            current++;
+        }
+        if (current < network.End(vertex)) {
+            path_.push_back(current);
+            continue;
+        }
+        if (path_.empty()) {
+            return false;
+        }
+        levels_[vertex] = kNone;
+        path_.pop_back();
+    }
+}
+
+template <class Capacity>
+Capacity Dinic<Capacity>::Augment(Network& network) {
+    Capacity flow = network.GetResidual(path_[0]);
+    for (size_t index : path_) {
+        flow = std::min(flow, network.GetResidual(index));
+    }
+    for (size_t index : path_) {
+        network.Push(index, flow);
+    }
+    for (size_t i = 0; i < path_.size(); i++) {
+        if (!IsLevelArc(network.GetResidual(path_[i]))) {
+            path_.resize(i);
+            break;
+        }
+    }
+    return flow;
+}
+
+template <class Capacity>
+typename Dinic<Capacity>::Flow Dinic<Capacity>::FindBlockingFlow(Network& network,
+                                                                 size_t source, size_t sink) {
+    size_t n = network.GetVerticesNumber();
+    statistics_.dynamic_tree_phases++;
+    forest_.Reset(n);
+    tree_arcs_.assign(n, kNone);
+    tree_residuals_.resize(n);
+    Flow flow = 0;
+    while (true) {
+        size_t vertex = forest_.FindRoot(source);
+        if (vertex == sink) {
+            Capacity bottleneck = forest_.FindMin(source).first;
+            forest_.SubtractFromPath(source, bottleneck);
+            forest_.SetValue(sink, LinkCutTree<Capacity>::kInfinity);
+            flow += bottleneck;
+            for (auto [residual, saturated] = forest_.FindMin(source); !IsLevelArc(residual);
+                 std::tie(residual, saturated) = forest_.FindMin(source)) {
+                CutTreeArc(network, saturated);
+            }
+            continue;
+        }
+        size_t& current = current_arcs_[vertex];
+        while (current < network.End(vertex) && !IsAdmissible(network, current, vertex)) {
+            current++;
+        }
+        if (current < network.End(vertex)) {
+            Capacity residual = network.GetResidual(current);
+            forest_.Link(vertex, network.GetHead(current), residual);
+            tree_arcs_[vertex] = current;
+            tree_residuals_[vertex] = residual;
+            continue;
+        }
+        if (vertex == source) {
+            break;
+        }
+        levels_[vertex] = kNone;
+        for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+            size_t to = network.GetHead(i);
+            if (tree_arcs_[to] == network.GetReverse(i)) {
+                CutTreeArc(network, to);
+            }
+        }
+    }
+    for (size_t vertex = 0; vertex < n; vertex++) {
+        if (tree_arcs_[vertex] != kNone) {
+            CutTreeArc(network, vertex);
+        }
+    }
+    return flow;
+}
+
+template <class Capacity>
+void Dinic<Capacity>::CutTreeArc(Network& network, size_t vertex) {
+    Capacity residual = forest_.Cut(vertex);
+    if constexpr (std::is_floating_point_v<Capacity>) {
+        residual = std::max<Capacity>(residual, 0);
+    }
+    network.Push(tree_arcs_[vertex], tree_residuals_[vertex] - residual);
+    tree_arcs_[vertex] = kNone;
+}
+
+template class CapacityScaling<size_t>;
+template class CapacityScaling<int32_t>;
+template class CapacityScaling<int64_t>;
+template class CapacityScaling<double>;
+template class Dinic<size_t>;
+template class Dinic<int32_t>;
+template class Dinic<int64_t>;
+template class Dinic<double>;
+}  // namespace max_flow_app
@@ -0,0 +1,107 @@
+#ifndef DINIC_H
+#define DINIC_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "link_cut_tree.h"
+#include "residual_network.h"
+#include "Library/bitset.h"
+#include "Library/thread_pool.h"
+
+namespace max_flow_app {
+template <class Capacity>
+class CapacityScaling {
+public:
+    CapacityScaling() = default;
+    explicit CapacityScaling(Capacity max_capacity);
+
+    Capacity GetThreshold() const;
+    bool IsResidual(Capacity capacity) const;
+    bool Next();
+
+private:
+    static constexpr double kRelativeEpsilon = 1e-12;
+    Capacity threshold_ = 0;
+    Capacity epsilon_ = 0;
+};
+
+extern template class CapacityScaling<size_t>;
+extern template class CapacityScaling<int32_t>;
+extern template class CapacityScaling<int64_t>;
+extern template class CapacityScaling<double>;
+
+enum class LevelGraphBuilder { TopDown, DirectionOptimizing, Parallel };
+
+enum class BlockingFlow { Augmenting, DynamicTrees, Adaptive };
+
+template <class Capacity>
+class Dinic {
+public:
+    using Network = BasicResidualNetwork<Capacity>;
+    using Flow =
+        std::conditional_t<std::is_integral_v<Capacity> && sizeof(Capacity) < sizeof(int64_t),
+                           int64_t, Capacity>;
+
+    struct Statistics {
+        size_t phases = 0;
+        size_t inspected_arcs = 0;
+        size_t dynamic_tree_phases = 0;
+        double level_graph_seconds = 0;
+    };
+
+    explicit Dinic(LevelGraphBuilder builder = LevelGraphBuilder::TopDown,
+                   size_t threads_number = std::thread::hardware_concurrency());
+    explicit Dinic(BlockingFlow blocking_flow,
+                   LevelGraphBuilder builder = LevelGraphBuilder::TopDown,
+                   size_t threads_number = std::thread::hardware_concurrency());
+
+    Flow Run(Network& network, size_t source, size_t sink);
+    const Statistics& GetStatistics() const;
+
+private:
+    bool BuildLevels(const Network& network, size_t source, size_t sink);
+    bool BuildLevelsTopDown(const Network& network, size_t source, size_t sink);
+    bool BuildLevelsDirectionOptimizing(const Network& network, size_t source, size_t sink);
+    bool BuildLevelsParallel(const Network& network, size_t source, size_t sink);
+    void StepTopDown(const Network& network, size_t level);
+    void StepBottomUp(const Network& network, size_t level);
+    bool IsLevelArc(Capacity residual) const;
+    bool FindPath(const Network& network, size_t source, size_t sink);
+    Capacity Augment(Network& network);
+    Flow FindBlockingFlow(Network& network, size_t source, size_t sink);
+    void CutTreeArc(Network& network, size_t vertex);
+    bool IsAdmissible(const Network& network, size_t index, size_t vertex) const;
+
+    static constexpr size_t kNone = std::string::npos;
+    static constexpr size_t kTopDownFactor = 14;
+    static constexpr size_t kBottomUpFactor = 24;
+    static constexpr size_t kGrain = 64;
+    static constexpr size_t kAugmentedArcsFactor = 4;
+    LevelGraphBuilder builder_;
+    BlockingFlow blocking_flow_ = BlockingFlow::Adaptive;
+    Statistics statistics_;
+    CapacityScaling<Capacity> scaling_;
+    std::vector<size_t> levels_;
+    std::vector<size_t> current_arcs_;
+    std::vector<size_t> path_;
+    std::vector<size_t> queue_;
+    std::vector<size_t> next_queue_;
+    bitset::DynamicBitset frontier_;
+    std::unique_ptr<thread_pool::ThreadPool> pool_;
+    std::vector<std::vector<size_t>> thread_frontiers_;
+    std::vector<size_t> thread_inspected_arcs_;
+    LinkCutTree<Capacity> forest_;
+    std::vector<size_t> tree_arcs_;
+    std::vector<Capacity> tree_residuals_;
+};
+
+extern template class Dinic<size_t>;
+extern template class Dinic<int32_t>;
+extern template class Dinic<int64_t>;
+extern template class Dinic<double>;
+}  // namespace max_flow_app
+#endif  // DINIC_H
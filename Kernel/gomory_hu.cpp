@@ -0,0 +1,147 @@
+#include "gomory_hu.h"
+#include <algorithm>
+#include <cassert>
+
+namespace max_flow_app {
+GomoryHuTree::GomoryHuTree(size_t threads_number)
+    : pool_(threads_number), workspaces_(pool_.GetThreadsNumber()) {
+}
+
+void GomoryHuTree::Build(size_t n, const std::vector<BasicEdge>& edges) {
+    n_ = n;
+    arcs_.clear();
+    for (auto [u, to, delta] : edges) {
+        assert(u < n_ && to < n_);
+        arcs_.push_back({u, to, delta});
+        arcs_.push_back({to, u, delta});
+    }
+    parents_.assign(n_, 0);
+    weights_.assign(n_, 0);
+    cut_parents_.assign(n_, kNone);
+    cut_values_.assign(n_, 0);
+    cut_sides_.assign(n_, bitset::DynamicBitset());
+    size_t window_size = kWindowFactor * pool_.GetThreadsNumber();
+    for (size_t vertex = 1; vertex < n_;) {
+        window_.clear();
+        for (size_t i = vertex; i < n_ && window_.size() < window_size; i++) {
+            if (cut_parents_[i] != parents_[i]) {
+                window_.push_back(i);
+            }
+        }
+        pool_.ParallelFor(window_.size(), [this](size_t index, size_t thread_id) {
+            ComputeCut(window_[index], workspaces_[thread_id]);
+        });
+        while (vertex < n_ && Commit(vertex)) {
+            vertex++;
+        }
+    }
+    cut_sides_.clear();
+    BuildOrder();
+}
+
+void GomoryHuTree::ComputeCut(size_t vertex, Workspace& workspace) {
+    size_t parent = parents_[vertex];
+    workspace.network.Build(n_, arcs_);
+    cut_values_[vertex] = workspace.dinic.Run(workspace.network, vertex, parent);
+    cut_parents_[vertex] = parent;
+    auto& side = cut_sides_[vertex];
+    side.Assign(n_);
+    side.Set(vertex);
+    workspace.queue.assign(1, vertex);
+    for (size_t head = 0; head < workspace.queue.size(); head++) {
+        size_t u = workspace.queue[head];
+        for (size_t i = workspace.network.Begin(u); i < workspace.network.End(u); i++) {
+            size_t to = workspace.network.GetHead(i);
+            if (workspace.network.GetResidual(i) && !side.Test(to)) {
+                side.Set(to);
+                workspace.queue.push_back(to);
+            }
+        }
+    }
+}
+
+bool GomoryHuTree::Commit(size_t vertex) {
+    size_t parent = parents_[vertex];
+    if (cut_parents_[vertex] != parent) {
+        return false;
+    }
+    weights_[vertex] = cut_values_[vertex];
+    const auto& side = cut_sides_[vertex];
+    for (size_t i = 0; i < n_; i++) {
+        if (i != vertex && parents_[i] == parent && side.Test(i)) {
+            parents_[i] = vertex;
+        }
+    }
+    if (side.Test(parents_[parent])) {
+        parents_[vertex] = parents_[parent];
+        parents_[parent] = vertex;
+        weights_[vertex] = weights_[parent];
+        weights_[parent] = cut_values_[vertex];
+    }
+    cut_sides_[vertex] = bitset::DynamicBitset();
+    return true;
+}
+
+void GomoryHuTree::BuildOrder() {
+    std::vector<size_t> offsets(n_ + 1), children(n_ ? n_ - 1 : 0);
+    for (size_t vertex = 1; vertex < n_; vertex++) {
+        offsets[parents_[vertex] + 1]++;
+    }
+    for (size_t i = 0; i < n_; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+    for (size_t vertex = 1; vertex < n_; vertex++) {
+        children[positions[parents_[vertex]]++] = vertex;
+    }
+    order_.assign(n_ ? 1 : 0, 0);
+    depths_.assign(n_, 0);
+    for (size_t head = 0; head < order_.size(); head++) {
+        size_t vertex = order_[head];
+        for (size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+            depths_[children[i]] = depths_[vertex] + 1;
+            order_.push_back(children[i]);
+        }
+    }
+    assert(order_.size() == n_);
+}
+
+size_t GomoryHuTree::GetVerticesNumber() const {
+    return n_;
+}
+
+size_t GomoryHuTree::GetParent(size_t vertex) const {
+    return parents_[vertex];
+}
+
+size_t GomoryHuTree::GetWeight(size_t vertex) const {
+    return weights_[vertex];
+}
+
+size_t GomoryHuTree::GetMinCut(size_t u, size_t v) const {
+    assert(u < n_ && v < n_ && u != v);
+    size_t cut = kNone;
+    while (u != v) {
+        if (depths_[u] < depths_[v]) {
+            std::swap(u, v);
+        }
+        cut = std::min(cut, weights_[u]);
+        u = parents_[u];
+    }
+    return cut;
+}
+
+std::vector<std::vector<size_t>> GomoryHuTree::GetAllPairsMinCuts() const {
+    std::vector<std::vector<size_t>> cuts(n_, std::vector<size_t>(n_, kNone));
+    for (size_t i = 1; i < n_; i++) {
+        size_t vertex = order_[i], parent = parents_[vertex];
+        for (size_t j = 0; j < i; j++) {
+            size_t other = order_[j];
+            cuts[vertex][other] = cuts[other][vertex] =
+                other == parent ? weights_[vertex]
+                                : std::min(weights_[vertex], cuts[parent][other]);
+        }
+    }
+    return cuts;
+}
+}  // namespace max_flow_app
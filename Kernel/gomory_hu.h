@@ -0,0 +1,54 @@
+#ifndef GOMORY_HU_H
+#define GOMORY_HU_H
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Library/bitset.h"
+#include "Library/thread_pool.h"
+#include "dinic.h"
+#include "kernel_messages.h"
+#include "residual_network.h"
+
+namespace max_flow_app {
+class GomoryHuTree {
+public:
+    using BasicEdge = kernel_messages::BasicEdge;
+
+    explicit GomoryHuTree(size_t threads_number = std::thread::hardware_concurrency());
+
+    void Build(size_t n, const std::vector<BasicEdge>& edges);
+    size_t GetVerticesNumber() const;
+    size_t GetParent(size_t vertex) const;
+    size_t GetWeight(size_t vertex) const;
+    size_t GetMinCut(size_t u, size_t v) const;
+    std::vector<std::vector<size_t>> GetAllPairsMinCuts() const;
+
+private:
+    struct Workspace {
+        ResidualNetwork network;
+        Dinic<size_t> dinic;
+        std::vector<size_t> queue;
+    };
+
+    void ComputeCut(size_t vertex, Workspace& workspace);
+    bool Commit(size_t vertex);
+    void BuildOrder();
+
+    static constexpr size_t kNone = std::string::npos;
+    static constexpr size_t kWindowFactor = 2;
+    thread_pool::ThreadPool pool_;
+    std::vector<Workspace> workspaces_;
+    size_t n_ = 0;
+    std::vector<BasicEdge> arcs_;
+    std::vector<size_t> parents_;
+    std::vector<size_t> weights_;
+    std::vector<size_t> cut_parents_;
+    std::vector<size_t> cut_values_;
+    std::vector<bitset::DynamicBitset> cut_sides_;
+    std::vector<size_t> window_;
+    std::vector<size_t> order_;
+    std::vector<size_t> depths_;
+};
+}  // namespace max_flow_app
+#endif  // GOMORY_HU_H
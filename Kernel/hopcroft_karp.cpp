@@ -0,0 +1,112 @@
+#include "hopcroft_karp.h"
+#include <cassert>
+
+namespace max_flow_app {
+size_t HopcroftKarp::Run(size_t left_number, size_t right_number, const std::vector<Edge>& edges,
+                         std::vector<size_t>& matched_edges) {
+    assert(matched_edges.size() == left_number);
+    BuildAdjacency(left_number, edges);
+    matched_left_.assign(right_number, kNone);
+    size_t matching = 0;
+    for (size_t vertex = 0; vertex < left_number; vertex++) {
+        if (matched_edges[vertex] != kNone) {
+            assert(edges[matched_edges[vertex]].left == vertex);
+            matched_left_[edges[matched_edges[vertex]].right] = vertex;
+            matching++;
+        }
+    }
+    while (BuildLayers(edges, matched_edges)) {
+        for (size_t vertex = 0; vertex < left_number; vertex++) {
+            current_edges_[vertex] = offsets_[vertex];
+        }
+        for (size_t vertex = 0; vertex < left_number; vertex++) {
+            if (matched_edges[vertex] == kNone && Augment(vertex, edges, matched_edges)) {
+                matching++;
+            }
+        }
+    }
+    return matching;
+}
+
+void HopcroftKarp::BuildAdjacency(size_t left_number, const std::vector<Edge>& edges) {
+    offsets_.assign(left_number + 1, 0);
+    for (const auto& edge : edges) {
+        offsets_[edge.left + 1]++;
+    }
+    for (size_t i = 0; i < left_number; i++) {
+        offsets_[i + 1] += offsets_[i];
+    }
+    adjacency_.resize(edges.size());
+    std::vector<size_t> positions(offsets_.begin(), offsets_.end() - 1);
+    for (size_t i = 0; i < edges.size(); i++) {
+        adjacency_[positions[edges[i].left]++] = i;
+    }
+    distances_.resize(left_number);
+    current_edges_.resize(left_number);
+}
+
+bool HopcroftKarp::BuildLayers(const std::vector<Edge>& edges,
+                               const std::vector<size_t>& matched_edges) {
+    queue_.clear();
+    for (size_t vertex = 0; vertex < distances_.size(); vertex++) {
+        distances_[vertex] = matched_edges[vertex] == kNone ? 0 : kNone;
+        if (!distances_[vertex]) {
+            queue_.push_back(vertex);
+        }
+    }
+    free_distance_ = kNone;
+    for (size_t head = 0; head < queue_.size(); head++) {
+        size_t vertex = queue_[head];
+        if (distances_[vertex] >= free_distance_) {
+            break;
+        }
+        for (size_t i = offsets_[vertex]; i < offsets_[vertex + 1]; i++) {
+            size_t next = matched_left_[edges[adjacency_[i]].right];
+            if (next == kNone) {
+                free_distance_ = distances_[vertex];
+            } else if (distances_[next] == kNone) {
+                distances_[next] = distances_[vertex] + 1;
+                queue_.push_back(next);
+            }
+        }
+    }
+    return free_distance_ != kNone;
+}
+
+bool HopcroftKarp::Augment(size_t vertex, const std::vector<Edge>& edges,
+                           std::vector<size_t>& matched_edges) {
+    path_.clear();
+    while (true) {
+        size_t& current = current_edges_[vertex];
+        size_t next = kNone;
+        for (; current < offsets_[vertex + 1]; current++) {
+            size_t right = edges[adjacency_[current]].right;
+            next = matched_left_[right];
+            if (next == kNone ? distances_[vertex] == free_distance_
+                              : distances_[next] == distances_[vertex] + 1) {
+                break;
+            }
+        }
+        if (current == offsets_[vertex + 1]) {
+            distances_[vertex] = kNone;
+            if (path_.empty()) {
+                return false;
+            }
+            vertex = edges[path_.back()].left;
+            path_.pop_back();
+            current_edges_[vertex]++;
+            continue;
+        }
+        path_.push_back(adjacency_[current]);
+        if (next == kNone) {
+            break;
+        }
+        vertex = next;
+    }
+    for (size_t edge_id : path_) {
+        matched_edges[edges[edge_id].left] = edge_id;
+        matched_left_[edges[edge_id].right] = edges[edge_id].left;
+    }
+    return true;
+}
+}  // namespace max_flow_app
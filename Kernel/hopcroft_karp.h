@@ -0,0 +1,35 @@
+#ifndef HOPCROFT_KARP_H
+#define HOPCROFT_KARP_H
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace max_flow_app {
+class HopcroftKarp {
+public:
+    struct Edge {
+        size_t left, right;
+    };
+
+    static constexpr size_t kNone = std::string::npos;
+
+    size_t Run(size_t left_number, size_t right_number, const std::vector<Edge>& edges,
+               std::vector<size_t>& matched_edges);
+
+private:
+    void BuildAdjacency(size_t left_number, const std::vector<Edge>& edges);
+    bool BuildLayers(const std::vector<Edge>& edges, const std::vector<size_t>& matched_edges);
+    bool Augment(size_t vertex, const std::vector<Edge>& edges,
+                 std::vector<size_t>& matched_edges);
+
+    std::vector<size_t> offsets_;
+    std::vector<size_t> adjacency_;
+    std::vector<size_t> matched_left_;
+    std::vector<size_t> distances_;
+    std::vector<size_t> current_edges_;
+    std::vector<size_t> queue_;
+    std::vector<size_t> path_;
+    size_t free_distance_ = kNone;
+};
+}  // namespace max_flow_app
+#endif  // HOPCROFT_KARP_H
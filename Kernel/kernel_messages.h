@@ -1,17 +1,33 @@
 #ifndef KERNEL_MESSAGES_H
 #define KERNEL_MESSAGES_H
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include "Library/bitset.h"
 
 namespace max_flow_app {
 namespace kernel_messages {
 enum class Status { Basic, OnTheNetwork, OnThePath };
 
-struct BasicEdge {
-    size_t u, to, delta = 0;
+enum class Engine {
+    Dinic,
+    PushRelabel,
+    ParallelPushRelabel,
+    BoykovKolmogorov,
+    MinCostFlow,
+    DirectionOptimizingDinic,
+    ParallelDinic
 };
 
+template <class Capacity>
+struct CapacityEdge {
+    size_t u, to;
+    Capacity delta = 0;
+};
+
+using BasicEdge = CapacityEdge<size_t>;
+
 struct Edge {
     size_t u, to, delta;
     Status status = Status::Basic;
@@ -28,6 +44,29 @@ struct MaxFlowData {
     bool operator==(const MaxFlowData& other) const = default;
 };
 
+struct FlowInstance {
+    size_t n;
+    std::vector<BasicEdge> edges;
+    size_t source = 0;
+    size_t sink = std::string::npos;
+};
+
+struct FlowResult {
+    size_t flow = 0;
+    std::vector<size_t> edge_flows;
+};
+
+struct SolveResult {
+    size_t flow = 0, upper_bound = 0;
+    bool is_complete = false;
+};
+
+struct MinCut {
+    bitset::DynamicBitset source_side;
+    std::vector<BasicEdge> edges;
+    size_t capacity = 0;
+};
+
 Status GetPreviousStatus(Status status);
 }  // namespace kernel_messages
 }  // namespace max_flow_app
@@ -0,0 +1,179 @@
+#include "link_cut_tree.h"
+#include <algorithm>
+#include <cassert>
+
+namespace max_flow_app {
+template <class Capacity>
+void LinkCutTree<Capacity>::Reset(size_t n) {
+    nodes_.assign(n, Node());
+}
+
+template <class Capacity>
+size_t LinkCutTree<Capacity>::FindRoot(size_t vertex) {
+    Access(vertex);
+    size_t root = vertex;
+    PushDown(root);
+    while (nodes_[root].children[0] != kNone) {
+        root = nodes_[root].children[0];
+        PushDown(root);
+    }
+    Splay(root);
+    return root;
+}
+
+template <class Capacity>
+std::pair<Capacity, size_t> LinkCutTree<Capacity>::FindMin(size_t vertex) {
+    Access(vertex);
+    size_t current = vertex;
+    while (true) {
+        PushDown(current);
+        const auto& node = nodes_[current];
+        size_t left = node.children[0], right = node.children[1];
+        Capacity best = node.value;
+        if (right != kNone && nodes_[right].min < best) {
+            best = nodes_[right].min;
+        }
+        if (left != kNone && nodes_[left].min <= best) {
+            current = left;
+        } else if (node.value == best) {
+            break;
+        } else {
+            current = right;
+        }
+    }
+    Splay(current);
+    return {nodes_[current].value, current};
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::SubtractFromPath(size_t vertex, Capacity delta) {
+    Access(vertex);
+    Apply(vertex, delta);
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::SetValue(size_t vertex, Capacity value) {
+    Access(vertex);
+    nodes_[vertex].value = value;
+    Update(vertex);
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::Link(size_t vertex, size_t parent, Capacity value) {
+    Access(vertex);
+    assert(nodes_[vertex].children[0] == kNone);
+    nodes_[vertex].value = value;
+    Update(vertex);
+    nodes_[vertex].parent = parent;
+}
+
+template <class Capacity>
+Capacity LinkCutTree<Capacity>::Cut(size_t vertex) {
+    Access(vertex);
+    size_t left = nodes_[vertex].children[0];
+    assert(left != kNone);
+    nodes_[left].parent = kNone;
+    nodes_[vertex].children[0] = kNone;
+    Capacity value = nodes_[vertex].value;
+    nodes_[vertex].value = kInfinity;
+    Update(vertex);
+    return value;
+}
+
+template <class Capacity>
+bool LinkCutTree<Capacity>::IsSplayRoot(size_t vertex) const {
+    size_t parent = nodes_[vertex].parent;
+    return parent == kNone || (nodes_[parent].children[0] != vertex &&
+                               nodes_[parent].children[1] != vertex);
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::Rotate(size_t vertex) {
+    size_t parent = nodes_[vertex].parent, grandparent = nodes_[parent].parent;
+    bool side = nodes_[parent].children[1] == vertex;
+    if (!IsSplayRoot(parent)) {
+        nodes_[grandparent].children[nodes_[grandparent].children[1] == parent] = vertex;
+    }
+    nodes_[vertex].parent = grandparent;
+    size_t child = nodes_[vertex].children[!side];
+    nodes_[parent].children[side] = child;
+    if (child != kNone) {
+        nodes_[child].parent = parent;
+    }
+    nodes_[vertex].children[!side] = parent;
+    nodes_[parent].parent = vertex;
+    Update(parent);
+    Update(vertex);
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::Splay(size_t vertex) {
+    stack_.assign(1, vertex);
+    for (size_t current = vertex; !IsSplayRoot(current); current = nodes_[current].parent) {
+        stack_.push_back(nodes_[current].parent);
+    }
+    for (size_t i = stack_.size(); i-- > 0;) {
+        PushDown(stack_[i]);
+    }
+    while (!IsSplayRoot(vertex)) {
+        size_t parent = nodes_[vertex].parent;
+        if (!IsSplayRoot(parent)) {
+            size_t grandparent = nodes_[parent].parent;
+            bool is_zig_zig = (nodes_[grandparent].children[1] == parent) ==
+                              (nodes_[parent].children[1] == vertex);
+            Rotate(is_zig_zig ? parent : vertex);
+        }
+        Rotate(vertex);
+    }
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::Access(size_t vertex) {
+    size_t last = kNone;
+    for (size_t current = vertex; current != kNone; current = nodes_[current].parent) {
+        Splay(current);
+        nodes_[current].children[1] = last;
+        Update(current);
+        last = current;
+    }
+    Splay(vertex);
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::Apply(size_t vertex, Capacity delta) {
+    auto& node = nodes_[vertex];
+    node.value -= delta;
+    node.min -= delta;
+    node.lazy += delta;
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::PushDown(size_t vertex) {
+    auto& node = nodes_[vertex];
+    if (node.lazy == 0) {
+        return;
+    }
+    for (size_t child : node.children) {
+        if (child != kNone) {
+            Apply(child, node.lazy);
+        }
+    }
+    node.lazy = 0;
+}
+
+template <class Capacity>
+void LinkCutTree<Capacity>::Update(size_t vertex) {
+    auto& node = nodes_[vertex];
+    node.min = node.value;
+    for (size_t child : node.children) {
+        if (child != kNone) {
+            node.min = std::min(node.min, nodes_[child].min);
+        }
+    }
+}
+
+template class LinkCutTree<size_t>;
+template class LinkCutTree<int32_t>;
+template class LinkCutTree<int64_t>;
+template class LinkCutTree<double>;
+}  // namespace max_flow_app
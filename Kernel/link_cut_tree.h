@@ -0,0 +1,49 @@
+#ifndef LINK_CUT_TREE_H
+#define LINK_CUT_TREE_H
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace max_flow_app {
+template <class Capacity>
+class LinkCutTree {
+public:
+    static constexpr Capacity kInfinity = std::numeric_limits<Capacity>::max();
+
+    void Reset(size_t n);
+    size_t FindRoot(size_t vertex);
+    std::pair<Capacity, size_t> FindMin(size_t vertex);
+    void SubtractFromPath(size_t vertex, Capacity delta);
+    void SetValue(size_t vertex, Capacity value);
+    void Link(size_t vertex, size_t parent, Capacity value);
+    Capacity Cut(size_t vertex);
+
+private:
+    struct Node {
+        size_t parent = kNone;
+        size_t children[2] = {kNone, kNone};
+        Capacity value = kInfinity, min = kInfinity, lazy = 0;
+    };
+
+    bool IsSplayRoot(size_t vertex) const;
+    void Rotate(size_t vertex);
+    void Splay(size_t vertex);
+    void Access(size_t vertex);
+    void Apply(size_t vertex, Capacity delta);
+    void PushDown(size_t vertex);
+    void Update(size_t vertex);
+
+    static constexpr size_t kNone = std::string::npos;
+    std::vector<Node> nodes_;
+    std::vector<size_t> stack_;
+};
+
+extern template class LinkCutTree<size_t>;
+extern template class LinkCutTree<int32_t>;
+extern template class LinkCutTree<int64_t>;
+extern template class LinkCutTree<double>;
+}  // namespace max_flow_app
+#endif  // LINK_CUT_TREE_H
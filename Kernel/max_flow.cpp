@@ -1,25 +1,372 @@
 #include "max_flow.h"
+#include <algorithm>
+#include <bit>
 #include <deque>
 #include <sys/types.h>
 #include <chrono>
 #include <string>
 
 namespace max_flow_app {
+MaxFlow::MaxFlow() {
+    ResetTerminals();
+}
+
 MaxFlow::MaxFlow(size_t n, size_t m, std::initializer_list<BasicEdge> edges)
     : n_(n),
       m_(m),
-      graph_(n),
       dist_(n_),
       processed_neighbors_(n),
       vertices_(n_, Status::Basic),
       rand_generator_(std::chrono::steady_clock::now().time_since_epoch().count()) {
-    AddEdges(std::move(edges));
+    AddEdges(edges);
+    ResetTerminals();
+}
+
+MaxFlow::MaxFlow(size_t n, const std::vector<BasicEdge>& edges)
+    : n_(n),
+      m_(edges.size()),
+      dist_(n_),
+      processed_neighbors_(n),
+      vertices_(n_, Status::Basic),
+      rand_generator_(std::chrono::steady_clock::now().time_since_epoch().count()) {
+    AddEdges(edges);
+    ResetTerminals();
+}
+
+void MaxFlow::RunRequest(Engine engine) {
+    SaveState();
+    if (deleted_edges_) {
+        CompactEdges();
+    }
+    if (engine != Engine::MinCostFlow &&
+        (engine != Engine::Dinic || !flow_observable_.HasSubscribers()) && IsMatchingNetwork()) {
+        RunMatching();
+        return;
+    }
+    if (engine == Engine::Dinic) {
+        RunDinic();
+        return;
+    }
+    if (engine == Engine::MinCostFlow) {
+        RunMinCostFlow();
+        return;
+    }
+    RunEngine(engine);
+}
+
+MaxFlow::SolveResult MaxFlow::SolveRequest(std::stop_token stop_token,
+                                           Clock::time_point deadline) {
+    SaveState();
+    if (deleted_edges_) {
+        CompactEdges();
+    }
+    stop_token_ = std::move(stop_token);
+    deadline_ = deadline;
+    RunDinic();
+    stop_token_ = std::stop_token();
+    deadline_ = Clock::time_point::max();
+    return {.flow = pushed_flow_,
+            .upper_bound = is_stopped_ ? GetFlowUpperBound() : pushed_flow_,
+            .is_complete = !is_stopped_};
+}
+
+void MaxFlow::RunEngine(Engine engine) {
+    bool is_reduced = IsFlowEmpty() && LoadReducedNetwork();
+    if (!is_reduced) {
+        LoadNetwork();
+    }
+    size_t source = is_reduced ? reduction_.GetSource() : GetEngineSource();
+    size_t sink = is_reduced ? reduction_.GetSink() : GetEngineSink();
+    switch (engine) {
+        case Engine::PushRelabel:
+            pushed_flow_ += push_relabel_.Run(network_, source, sink);
+            break;
+        case Engine::ParallelPushRelabel:
+            if (!parallel_push_relabel_) {
+                parallel_push_relabel_ = std::make_unique<ParallelPushRelabel>();
+            }
+            pushed_flow_ += parallel_push_relabel_->Run(network_, source, sink);
+            break;
+        case Engine::BoykovKolmogorov:
+            pushed_flow_ += boykov_kolmogorov_.Run(network_, source, sink);
+            break;
+        case Engine::DirectionOptimizingDinic:
+            pushed_flow_ += direction_optimizing_dinic_.Run(network_, source, sink);
+            break;
+        case Engine::ParallelDinic:
+            if (!parallel_dinic_) {
+                parallel_dinic_ = std::make_unique<Dinic<size_t>>(LevelGraphBuilder::Parallel);
+            }
+            pushed_flow_ += parallel_dinic_->Run(network_, source, sink);
+            break;
+        default:
+            assert(0);
+    }
+    if (is_reduced) {
+        StoreReducedNetwork();
+    } else {
+        StoreNetwork();
+    }
+    flow_rate_ = 0;
+    SetGraphToBasicStatus(false);
+    unlock_observable_.Notify();
+}
+
+void MaxFlow::RunMinCostFlow() {
+    for (size_t i = 0; i < edges_.size(); i++) {
+        edges_[i].delta = capacities_[i];
+    }
+    for (auto [u, to, delta] : GetVirtualEdges()) {
+        edges_.push_back({.u = u, .to = to, .delta = delta});
+        edges_.push_back({.u = to, .to = u, .delta = 0});
+        costs_.push_back(0);
+        costs_.push_back(0);
+    }
+    pushed_flow_ = min_cost_flow_
+                       .Run(GetEngineVerticesNumber(), edges_, costs_, GetEngineSource(),
+                            GetEngineSink())
+                       .value_or(0);
+    edges_.resize(m_ << 1);
+    costs_.resize(m_ << 1);
+    flow_rate_ = 0;
+    SetGraphToBasicStatus(false);
+    unlock_observable_.Notify();
+}
+
+bool MaxFlow::IsMatchingNetwork() const {
+    if (IsMultiTerminal() || !m_) {
+        return false;
+    }
+    size_t source = sources_[0], sink = sinks_[0];
+    bitset::DynamicBitset is_left(n_), is_right(n_);
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        const auto& edge = edges_[i];
+        if (capacities_[i] != 1 || capacities_[i + 1] || edge.to == source || edge.u == sink ||
+            (edge.u == source && edge.to == sink)) {
+            return false;
+        }
+        if (edge.u == source) {
+            if (is_left.Test(edge.to)) {
+                return false;
+            }
+            is_left.Set(edge.to);
+        } else if (edge.to == sink) {
+            if (is_right.Test(edge.u)) {
+                return false;
+            }
+            is_right.Set(edge.u);
+        }
+    }
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        size_t u = edges_[i].u, to = edges_[i].to;
+        if (u == source ? is_right.Test(to)
+                        : to != sink && !(is_left.Test(u) && is_right.Test(to))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MaxFlow::RunMatching() {
+    constexpr size_t kNone = HopcroftKarp::kNone;
+    size_t source = sources_[0], sink = sinks_[0];
+    std::vector<size_t> indices(n_, kNone), source_edges, sink_edges;
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        if (edges_[i].u == source) {
+            indices[edges_[i].to] = source_edges.size();
+            source_edges.push_back(i);
+        } else if (edges_[i].to == sink) {
+            indices[edges_[i].u] = sink_edges.size();
+            sink_edges.push_back(i);
+        }
+    }
+    std::vector<HopcroftKarp::Edge> edges;
+    std::vector<size_t> edge_ids, matched_edges(source_edges.size(), kNone);
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        const auto& edge = edges_[i];
+        if (edge.u == source || edge.to == sink) {
+            continue;
+        }
+        if (!edge.delta) {
+            matched_edges[indices[edge.u]] = edges.size();
+        }
+        edges.push_back({.left = indices[edge.u], .right = indices[edge.to]});
+        edge_ids.push_back(i);
+    }
+    pushed_flow_ =
+        hopcroft_karp_.Run(source_edges.size(), sink_edges.size(), edges, matched_edges);
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        edges_[i].delta = 1;
+        edges_[i + 1].delta = 0;
+    }
+    for (size_t edge_id : matched_edges) {
+        if (edge_id == kNone) {
+            continue;
+        }
+        for (size_t i : {source_edges[edges[edge_id].left], edge_ids[edge_id],
+                         sink_edges[edges[edge_id].right]}) {
+            edges_[i].delta = 0;
+            edges_[i + 1].delta = 1;
+        }
+    }
+    flow_rate_ = 0;
+    SetGraphToBasicStatus(false);
+    unlock_observable_.Notify();
+}
+
+int64_t MaxFlow::GetFlowCost() const {
+    int64_t cost = 0;
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        cost += costs_[i] * (static_cast<int64_t>(capacities_[i]) -
+                             static_cast<int64_t>(edges_[i].delta));
+    }
+    return cost;
+}
+
+std::vector<MaxFlow::BasicEdge> MaxFlow::GetEngineEdges() const {
+    std::vector<BasicEdge> edges;
+    edges.reserve(m_);
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        edges.push_back({.u = edges_[i].u, .to = edges_[i].to, .delta = edges_[i].delta});
+    }
+    for (const auto& edge : GetVirtualEdges()) {
+        edges.push_back(edge);
+    }
+    return edges;
+}
+
+bool MaxFlow::IsFlowEmpty() const {
+    for (size_t i = 0; i < edges_.size(); i++) {
+        if (edges_[i].delta != capacities_[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
-void MaxFlow::RunRequest() {
+bool MaxFlow::LoadReducedNetwork() {
+    auto edges = GetEngineEdges();
+    for (size_t i = 1; i < edges_.size(); i += 2) {
+        edges.push_back({.u = edges_[i].u, .to = edges_[i].to, .delta = capacities_[i]});
+    }
+    if (!NetworkReduction::IsWorthwhile(GetEngineVerticesNumber(), edges, GetEngineSource(),
+                                        GetEngineSink())) {
+        return false;
+    }
+    reduction_.Build(GetEngineVerticesNumber(), edges, GetEngineSource(), GetEngineSink());
+    network_.Build(reduction_.GetVerticesNumber(), reduction_.GetEdges());
+    return true;
+}
+
+void MaxFlow::StoreReducedNetwork() {
+    std::vector<size_t> flows(network_.GetEdgesNumber());
+    for (size_t i = 0; i < flows.size(); i++) {
+        flows[i] = network_.GetFlow(i);
+    }
+    auto edge_flows = reduction_.RestoreFlows(flows);
+    size_t reverse_offset = edge_flows.size() - m_;
+    for (size_t i = 0; i < m_; i++) {
+        size_t flow = edge_flows[i], reverse_flow = edge_flows[reverse_offset + i];
+        edges_[i << 1].delta = capacities_[i << 1] + reverse_flow - flow;
+        edges_[(i << 1) + 1].delta = capacities_[(i << 1) + 1] + flow - reverse_flow;
+    }
+}
+
+void MaxFlow::LoadNetwork() {
+    network_.Build(GetEngineVerticesNumber(), GetEngineEdges());
+    for (size_t i = 0; i < m_; i++) {
+        size_t reverse = network_.GetReverse(network_.GetEdgeArc(i));
+        network_.GetResidual(reverse) = edges_[(i << 1) + 1].delta;
+    }
+}
+
+void MaxFlow::StoreNetwork() {
+    for (size_t i = 0; i < m_; i++) {
+        size_t index = network_.GetEdgeArc(i);
+        edges_[i << 1].delta = network_.GetResidual(index);
+        edges_[(i << 1) + 1].delta = network_.GetResidual(network_.GetReverse(index));
+    }
+}
+
+bool MaxFlow::IsMultiTerminal() const {
+    return sources_.size() > 1 || sinks_.size() > 1;
+}
+
+size_t MaxFlow::GetEngineVerticesNumber() const {
+    return IsMultiTerminal() ? n_ + 2 : n_;
+}
+
+size_t MaxFlow::GetEngineSource() const {
+    return IsMultiTerminal() ? n_ : sources_[0];
+}
+
+size_t MaxFlow::GetEngineSink() const {
+    return IsMultiTerminal() ? n_ + 1 : sinks_[0];
+}
+
+std::vector<MaxFlow::BasicEdge> MaxFlow::GetVirtualEdges() const {
+    std::vector<BasicEdge> edges;
+    if (!IsMultiTerminal()) {
+        return edges;
+    }
+    std::vector<size_t> out_capacities(n_), in_capacities(n_);
+    for (const auto& edge : edges_) {
+        out_capacities[edge.u] += edge.delta;
+        in_capacities[edge.to] += edge.delta;
+    }
+    for (size_t source : sources_) {
+        edges.push_back({.u = n_, .to = source, .delta = out_capacities[source]});
+    }
+    for (size_t sink : sinks_) {
+        edges.push_back({.u = sink, .to = n_ + 1, .delta = in_capacities[sink]});
+    }
+    return edges;
+}
+
+void MaxFlow::SetTerminalsRequest(size_t source, size_t sink) {
+    SetTerminalsRequest(std::vector<size_t>{source}, std::vector<size_t>{sink});
+}
+
+void MaxFlow::SetTerminalsRequest(const std::vector<size_t>& sources,
+                                  const std::vector<size_t>& sinks) {
+    if (sources.empty() || sinks.empty()) {
+        return;
+    }
+    bitset::DynamicBitset is_source(n_);
+    for (size_t source : sources) {
+        if (source >= n_) {
+            return;
+        }
+        is_source.Set(source);
+    }
+    for (size_t sink : sinks) {
+        if (sink >= n_ || is_source.Test(sink)) {
+            return;
+        }
+    }
     SaveState();
-    while (true) {
-        while (!FindNetwork()) {
+    SetTerminals(sources, sinks);
+    ResetState();
+}
+
+void MaxFlow::SetTerminals(std::vector<size_t> sources, std::vector<size_t> sinks) {
+    sources_ = std::move(sources);
+    sinks_ = std::move(sinks);
+    is_sink_.Assign(n_);
+    for (size_t sink : sinks_) {
+        is_sink_.Set(sink);
+    }
+}
+
+void MaxFlow::ResetTerminals() {
+    SetTerminals({0}, {n_ - 1});
+}
+
+void MaxFlow::RunDinic() {
+    BuildAdjacency();
+    is_stopped_ = false;
+    while (!is_stopped_) {
+        while (!FindNetwork() && !is_stopped_) {
             if (flow_rate_ == 0) {
                 SetGraphToBasicStatus(false);
                 unlock_observable_.Notify();
@@ -28,33 +375,131 @@ void MaxFlow::RunRequest() {
             SetGraphToBasicStatus(true);
             flow_rate_--;
         }
+        if (is_stopped_) {
+            break;
+        }
         std::vector<size_t> path;
-        processed_neighbors_.assign(n_, 0);
-        while (FindPath(0, path)) {
+        current_source_ = 0;
+        while (!IsStopRequested() && FindPath(path)) {
             ProcessPath(path);
             SetPathToBasicStatus(path);
-            path.clear();
+            RetreatPath(path);
         }
         SetGraphToBasicStatus(true);
     }
+    SetGraphToBasicStatus(false);
+    unlock_observable_.Notify();
+}
+
+bool MaxFlow::IsStopRequested() {
+    if (stop_token_.stop_requested() ||
+        (deadline_ != Clock::time_point::max() && Clock::now() >= deadline_)) {
+        is_stopped_ = true;
+    }
+    return is_stopped_;
+}
+
+size_t MaxFlow::GetFlowUpperBound() {
+    BuildAdjacency();
+    std::vector<size_t> dist(n_, std::string::npos);
+    std::deque<size_t> queue(sources_.begin(), sources_.end());
+    for (size_t source : sources_) {
+        dist[source] = 0;
+    }
+    size_t sink_dist = std::string::npos;
+    while (!queue.empty()) {
+        size_t vertex = ExtractVertice(queue);
+        if (is_sink_.Test(vertex)) {
+            sink_dist = dist[vertex];
+            break;
+        }
+        for (size_t i = adjacency_offsets_[vertex]; i < adjacency_offsets_[vertex + 1]; i++) {
+            const Edge& edge = GetEdge(adjacency_[i]);
+            if (edge.delta && dist[edge.to] == std::string::npos) {
+                dist[edge.to] = dist[vertex] + 1;
+                queue.push_back(edge.to);
+            }
+        }
+    }
+    if (sink_dist == std::string::npos) {
+        return pushed_flow_;
+    }
+    std::vector<size_t> cut_capacities(sink_dist + 1);
+    for (size_t i = 0; i < edges_.size(); i++) {
+        size_t from = dist[edges_[i].u], to = std::min(dist[edges_[i].to], sink_dist);
+        if (capacities_[i] && from < to) {
+            cut_capacities[from] += capacities_[i];
+            cut_capacities[to] -= capacities_[i];
+        }
+    }
+    size_t upper_bound = std::string::npos, capacity = 0;
+    for (size_t level = 0; level < sink_dist; level++) {
+        capacity += cut_capacities[level];
+        upper_bound = std::min(upper_bound, capacity);
+    }
+    return upper_bound;
 }
 
 size_t MaxFlow::FindEdge(const MaxFlow::BasicEdge& edge) {
-    for (auto e = edges_.begin(); e != edges_.end(); e++) {
-        if ((*e).u == edge.u && (*e).to == edge.to) {
-            return e - edges_.begin();
+    BuildEdgeIndex();
+    auto it = edge_index_.find({edge.u, edge.to});
+    return it == edge_index_.end() ? std::string::npos : it->second.first;
+}
+
+void MaxFlow::BuildEdgeIndex() {
+    if (is_edge_index_actual_) {
+        return;
+    }
+    edge_index_.clear();
+    edge_index_.reserve(edges_.size() - 2 * deleted_edges_);
+    next_same_arcs_.assign(edges_.size(), std::string::npos);
+    prev_same_arcs_.assign(edges_.size(), std::string::npos);
+    for (size_t i = 0; i < edges_.size(); i++) {
+        if (!is_deleted_[i >> 1]) {
+            AppendToEdgeIndex(i);
         }
     }
-    return std::string::npos;
+    is_edge_index_actual_ = true;
 }
 
-void MaxFlow::AddEdgeRequest(const MaxFlow::BasicEdge& edge) {
+void MaxFlow::AppendToEdgeIndex(size_t index) {
+    auto [it, is_inserted] =
+        edge_index_.try_emplace({edges_[index].u, edges_[index].to}, ArcChain{index, index});
+    if (!is_inserted) {
+        next_same_arcs_[it->second.last] = index;
+        prev_same_arcs_[index] = it->second.last;
+        it->second.last = index;
+    }
+}
+
+void MaxFlow::RemoveFromEdgeIndex(size_t index) {
+    auto it = edge_index_.find({edges_[index].u, edges_[index].to});
+    size_t prev = prev_same_arcs_[index], next = next_same_arcs_[index];
+    if (prev == std::string::npos && next == std::string::npos) {
+        edge_index_.erase(it);
+        return;
+    }
+    (prev == std::string::npos ? it->second.first : next_same_arcs_[prev]) = next;
+    (next == std::string::npos ? it->second.last : prev_same_arcs_[next]) = prev;
+}
+
+void MaxFlow::RestoreToEdgeIndex(size_t index, size_t prev, size_t next) {
+    auto it = edge_index_.try_emplace({edges_[index].u, edges_[index].to}, ArcChain{index, index})
+                  .first;
+    prev_same_arcs_[index] = prev;
+    next_same_arcs_[index] = next;
+    (prev == std::string::npos ? it->second.first : next_same_arcs_[prev]) = index;
+    (next == std::string::npos ? it->second.last : prev_same_arcs_[next]) = index;
+}
+
+void MaxFlow::AddEdgeRequest(const MaxFlow::BasicEdge& edge, int64_t cost) {
     if (!IsValid(edge)) {
         return;
     }
-    SaveState();
-    AddEdge(edge);
-    ResetState();
+    SaveEditState();
+    AddEdge(edge, cost);
+    flow_rate_ = std::max(flow_rate_, GetFlowRate(edge.delta));
+    SetGraphToBasicStatus(false);
 }
 
 bool MaxFlow::IsValid(const BasicEdge& edge) {
@@ -62,139 +507,340 @@ bool MaxFlow::IsValid(const BasicEdge& edge) {
 }
 
 void MaxFlow::DeleteEdgeRequest(const MaxFlow::BasicEdge& edge) {
-    SaveState();
-    size_t index = 0;
-    for (Edge& e : edges_) {
-        if (e.u == edge.u && e.to == edge.to) {
-            break;
+    DeleteEdgesRequest({edge});
+}
+
+void MaxFlow::DeleteEdgesRequest(const std::vector<BasicEdge>& edges) {
+    SaveEditState();
+    bool is_deleted = false;
+    for (const auto& edge : edges) {
+        size_t lost_flow;
+        if (DeleteEdge(edge, lost_flow)) {
+            is_deleted = true;
+            flow_rate_ = std::max(flow_rate_, GetFlowRate(lost_flow));
         }
-        index++;
     }
-    if (index == edges_.size()) {
+    if (!is_deleted) {
         return;
     }
+    if (deleted_edges_ > m_) {
+        CompactEdges();
+    }
+    SetGraphToBasicStatus(false);
+}
+
+bool MaxFlow::DeleteEdge(const BasicEdge& edge, size_t& lost_flow) {
+    size_t index = FindEdge(edge);
+    if (index == std::string::npos) {
+        return false;
+    }
     index = std::min(index, index ^ 1);
-    edges_.erase(edges_.begin() + index);
-    edges_.erase(edges_.begin() + index);
-
-    for (auto& edges : graph_) {
-        size_t deleted_index = edges.size();
-        for (size_t i = 0; i < edges.size(); i++) {
-            if ((edges[i] ^ index) <= 1) {
-                deleted_index = i;
-                break;
+    RecordArc(index);
+    RecordArc(index + 1);
+    lost_flow = RepairFlow(index);
+    capacities_[index] = capacities_[index + 1] = 0;
+    is_deleted_[index >> 1] = true;
+    for (size_t arc = index; arc < index + 2; arc++) {
+        if (IsEditRecorded()) {
+            previous_states_.back().deleted_arcs.push_back(
+                {.index = arc, .prev = prev_same_arcs_[arc], .next = next_same_arcs_[arc]});
+        }
+        RemoveFromEdgeIndex(arc);
+    }
+    deleted_edges_++;
+    m_--;
+    return true;
+}
+
+void MaxFlow::CompactEdges() {
+    // Arcs deleted by edits that can still be undone are kept as tombstones, and the indices
+    // in their records are shifted together with the arcs.
+    auto edits = std::find_if(previous_states_.rbegin(), previous_states_.rend(),
+                              [](const State& state) { return state.snapshot.has_value(); })
+                     .base();
+    std::vector<bool> is_kept(is_deleted_.size());
+    for (size_t i = 0; i < is_kept.size(); i++) {
+        is_kept[i] = !is_deleted_[i];
+    }
+    for (auto it = edits; it != previous_states_.end(); it++) {
+        for (const auto& arc : it->deleted_arcs) {
+            is_kept[arc.index >> 1] = true;
+        }
+    }
+    std::vector<size_t> new_indices(edges_.size() + 1);
+    size_t size = 0;
+    for (size_t i = 0; i < edges_.size(); i += 2) {
+        new_indices[i] = size;
+        new_indices[i + 1] = size + 1;
+        if (!is_kept[i >> 1]) {
+            continue;
+        }
+        is_deleted_[size >> 1] = is_deleted_[i >> 1];
+        for (size_t j = i; j < i + 2; j++) {
+            edges_[size] = edges_[j];
+            capacities_[size] = capacities_[j];
+            costs_[size++] = costs_[j];
+        }
+    }
+    new_indices[edges_.size()] = size;
+    edges_.resize(size);
+    capacities_.resize(size);
+    costs_.resize(size);
+    is_deleted_.resize(size >> 1);
+    deleted_edges_ = (size >> 1) - m_;
+    auto remap = [&new_indices](size_t index) {
+        return index == std::string::npos ? index : new_indices[index];
+    };
+    for (auto it = edits; it != previous_states_.end(); it++) {
+        it->arcs_number = new_indices[it->arcs_number];
+        for (auto& arc : it->arcs) {
+            arc.index = new_indices[arc.index];
+        }
+        for (auto& arc : it->deleted_arcs) {
+            arc = {.index = new_indices[arc.index], .prev = remap(arc.prev),
+                   .next = remap(arc.next)};
+        }
+    }
+    if (is_adjacency_actual_) {
+        size_t adjacency_size = 0, begin = 0;
+        for (size_t vertex = 0; vertex < n_; vertex++) {
+            size_t end = adjacency_offsets_[vertex + 1];
+            adjacency_offsets_[vertex] = adjacency_size;
+            for (size_t i = begin; i < end; i++) {
+                if (is_kept[adjacency_[i] >> 1]) {
+                    adjacency_[adjacency_size++] = new_indices[adjacency_[i]];
+                }
             }
+            begin = end;
+        }
+        adjacency_offsets_[n_] = adjacency_size;
+        adjacency_.resize(adjacency_size);
+    }
+    is_edge_index_actual_ = false;
+}
+
+size_t MaxFlow::RepairFlow(size_t index) {
+    Edge& edge = GetEdge(index);
+    size_t from = edge.u, to = edge.to, flow;
+    if (capacities_[index] >= edge.delta) {
+        flow = capacities_[index] - edge.delta;
+    } else {
+        flow = edge.delta - capacities_[index];
+        std::swap(from, to);
+    }
+    edge.delta = GetReverseEdge(index).delta = 0;
+    if (!flow) {
+        return 0;
+    }
+    BuildAdjacency();
+    size_t lost_flow = flow - PushFlow({from}, {to}, flow);
+    if (lost_flow) {
+        [[maybe_unused]] size_t returned_flow = PushFlow({from}, sources_, lost_flow);
+        [[maybe_unused]] size_t cancelled_flow = PushFlow(sinks_, {to}, lost_flow);
+        assert(returned_flow == lost_flow && cancelled_flow == lost_flow);
+        pushed_flow_ -= lost_flow;
+    }
+    return lost_flow;
+}
+
+size_t MaxFlow::PushFlow(const std::vector<size_t>& from, const std::vector<size_t>& to,
+                         size_t limit) {
+    ResizeVisitBuffers();
+    for (size_t vertex : to) {
+        is_push_target_.Set(vertex);
+    }
+    size_t pushed_flow = 0;
+    for (size_t vertex : from) {
+        if (is_push_target_.Test(vertex)) {
+            pushed_flow = limit;
         }
-        if (deleted_index != edges.size()) {
-            edges.erase(edges.begin() + deleted_index);
+    }
+    std::deque<size_t> queue;
+    while (pushed_flow < limit) {
+        visit_stamp_++;
+        for (size_t vertex : from) {
+            Visit(vertex, 0, -1);
         }
-        for (auto& edge : edges) {
-            if (edge > index) {
-                edge -= 2;
+        queue.assign(from.begin(), from.end());
+        size_t target = std::string::npos;
+        while (!queue.empty() && target == std::string::npos) {
+            size_t vertex = ExtractVertice(queue);
+            for (size_t i = adjacency_offsets_[vertex]; i < adjacency_offsets_[vertex + 1]; i++) {
+                size_t edge_id = adjacency_[i];
+                const Edge& edge = GetEdge(edge_id);
+                if (edge.delta && !IsVisited(edge.to)) {
+                    Visit(edge.to, dist_[vertex] + 1, static_cast<ssize_t>(edge_id));
+                    queue.push_back(edge.to);
+                    if (is_push_target_.Test(edge.to)) {
+                        target = edge.to;
+                        break;
+                    }
+                }
             }
         }
+        if (target == std::string::npos) {
+            break;
+        }
+        size_t flow = limit - pushed_flow;
+        for (size_t vertex = target; parent_[vertex] != -1; vertex = GetEdge(parent_[vertex]).u) {
+            flow = std::min(flow, GetEdge(parent_[vertex]).delta);
+        }
+        for (size_t vertex = target; parent_[vertex] != -1; vertex = GetEdge(parent_[vertex]).u) {
+            RecordArc(parent_[vertex]);
+            RecordArc(parent_[vertex] ^ 1);
+            GetEdge(parent_[vertex]).delta -= flow;
+            GetReverseEdge(parent_[vertex]).delta += flow;
+        }
+        pushed_flow += flow;
     }
-    m_--;
-    ResetState();
+    for (size_t vertex : to) {
+        is_push_target_.Reset(vertex);
+    }
+    return pushed_flow;
 }
 
-void MaxFlow::ExtendNetwork(size_t vertex, std::vector<bool>& used, std::vector<ssize_t>& parent,
-                            std::deque<size_t>& queue) {
-    for (auto edge_id : graph_[vertex]) {
+void MaxFlow::ExtendNetwork(size_t vertex, std::deque<size_t>& queue) {
+    for (size_t i = adjacency_offsets_[vertex]; i < adjacency_offsets_[vertex + 1]; i++) {
+        size_t edge_id = adjacency_[i];
         auto [u, to, delta, _] = GetEdge(edge_id);
-        if (delta < (1u << flow_rate_)) {
+        if (delta < GetFlowUnit()) {
             continue;
         }
-        if (!used[to]) {
-            parent[to] = edge_id;
-            dist_[to] = dist_[u] + 1;
-            used[to] = 1;
+        if (!IsVisited(to)) {
+            Visit(to, dist_[u] + 1, static_cast<ssize_t>(edge_id));
             queue.push_back(to);
         }
     }
 }
 
-void MaxFlow::ChangeNewEdgeStatus(size_t vertex, const std::vector<ssize_t>& parent) {
-    if (vertex) {
-        edges_[parent[vertex]].status = Status::OnTheNetwork;
-        updated_edge_ = parent[vertex];
+void MaxFlow::ChangeNewEdgeStatus(size_t vertex) {
+    if (parent_[vertex] != -1) {
+        MarkEdge(parent_[vertex], Status::OnTheNetwork);
+        updated_edge_ = parent_[vertex];
         flow_observable_.Notify();
-        vertices_[vertex] = Status::OnTheNetwork;
+        MarkVertex(vertex, Status::OnTheNetwork);
         updated_edge_ = std::string::npos;
         flow_observable_.Notify();
     }
 }
 
+bool MaxFlow::IsVisited(size_t vertex) const {
+    return visit_stamps_[vertex] == visit_stamp_;
+}
+
+void MaxFlow::Visit(size_t vertex, size_t dist, ssize_t parent) {
+    visit_stamps_[vertex] = visit_stamp_;
+    dist_[vertex] = dist;
+    parent_[vertex] = parent;
+    processed_neighbors_[vertex] = 0;
+}
+
+void MaxFlow::ResizeVisitBuffers() {
+    if (visit_stamps_.size() == n_) {
+        return;
+    }
+    visit_stamps_.assign(n_, 0);
+    dist_.resize(n_);
+    parent_.resize(n_);
+    processed_neighbors_.resize(n_);
+    is_push_target_.Assign(n_);
+}
+
 size_t MaxFlow::ExtractVertice(std::deque<size_t>& queue) {
     size_t i = queue.front();
     queue.pop_front();
     return i;
 }
 
-void MaxFlow::FindingNetworkInit(std::deque<size_t>& queue, std::vector<ssize_t>& parent,
-                                 std::vector<bool>& used) {
-    queue = {0};
-    parent.assign(n_, -1);
-    dist_.assign(n_, n_ + 1);
-    used.assign(n_, 0);
-    used[0] = 1;
-    dist_[0] = 0;
-    vertices_[0] = Status::OnTheNetwork;
+void MaxFlow::FindingNetworkInit(std::deque<size_t>& queue) {
+    queue.assign(sources_.begin(), sources_.end());
+    ResizeVisitBuffers();
+    visit_stamp_++;
+    for (size_t source : sources_) {
+        Visit(source, 0, -1);
+        MarkVertex(source, Status::OnTheNetwork);
+    }
     updated_edge_ = std::string::npos;
     flow_observable_.Notify();
 }
 
 bool MaxFlow::FindNetwork() {
     std::deque<size_t> queue;
-    std::vector<ssize_t> parent(n_);
-    std::vector<bool> used(n_);
 
-    FindingNetworkInit(queue, parent, used);
-    while (!queue.empty()) {
+    FindingNetworkInit(queue);
+    for (size_t extracted = 1; !queue.empty(); extracted++) {
+        if (extracted % kStopCheckPeriod == 0 && IsStopRequested()) {
+            return false;
+        }
         size_t i = ExtractVertice(queue);
-        ChangeNewEdgeStatus(i, parent);
-        ExtendNetwork(i, used, parent, queue);
+        ChangeNewEdgeStatus(i);
+        ExtendNetwork(i, queue);
     }
-    return used[n_ - 1];
+    for (size_t sink : sinks_) {
+        if (IsVisited(sink)) {
+            return true;
+        }
+    }
+    return false;
 }
 
-bool MaxFlow::FindPath(size_t vertex, std::vector<size_t>& path) {
-    if (vertex == n_ - 1) {
-        return true;
-    }
-    while (processed_neighbors_[vertex] < graph_[vertex].size()) {
-        size_t edge_id = graph_[vertex][processed_neighbors_[vertex]++];
-        auto [u, to, delta, _] = GetEdge(edge_id);
-        if (delta < (1 << flow_rate_) || dist_[u] + 1 != dist_[to]) {
+bool MaxFlow::IsAdmissible(size_t edge_id) const {
+    const Edge& edge = GetEdge(edge_id);
+    return edge.delta >= GetFlowUnit() && IsVisited(edge.to) &&
+           dist_[edge.u] + 1 == dist_[edge.to];
+}
+
+bool MaxFlow::FindPath(std::vector<size_t>& path) {
+    while (current_source_ < sources_.size()) {
+        size_t vertex = path.empty() ? sources_[current_source_] : GetEdge(path.back()).to;
+        if (is_sink_.Test(vertex)) {
+            return true;
+        }
+        size_t begin = adjacency_offsets_[vertex];
+        size_t degree = adjacency_offsets_[vertex + 1] - begin;
+        size_t& current = processed_neighbors_[vertex];
+        while (current < degree && !IsAdmissible(adjacency_[begin + current])) {
+            current++;
+        }
+        if (current < degree) {
+            path.push_back(adjacency_[begin + current]);
             continue;
         }
-        if (FindPath(to, path)) {
-            path.push_back(edge_id);
-            if (!vertex) {
-                reverse(path.begin(), path.end());
-            }
-            return true;
+        if (path.empty()) {
+            current_source_++;
+            continue;
         }
+        path.pop_back();
+        processed_neighbors_[path.empty() ? sources_[current_source_] : GetEdge(path.back()).to]++;
     }
     return false;
 }
 
+void MaxFlow::RetreatPath(std::vector<size_t>& path) {
+    for (size_t i = 0; i < path.size(); i++) {
+        if (!IsAdmissible(path[i])) {
+            path.resize(i);
+            return;
+        }
+    }
+}
+
 void MaxFlow::ProcessPath(const std::vector<size_t>& path) {
-    vertices_[0] = Status::OnThePath;
+    MarkVertex(GetEdge(path.front()).u, Status::OnThePath);
     updated_edge_ = std::string::npos;
     flow_observable_.Notify();
 
     for (size_t edge_id : path) {
-        GetEdge(edge_id).status = Status::OnThePath;
+        MarkEdge(edge_id, Status::OnThePath);
         updated_edge_ = edge_id;
         flow_observable_.Notify();
-        GetEdge(edge_id).delta -= (1 << flow_rate_);
-        GetReverseEdge(edge_id).delta += (1 << flow_rate_);
-        vertices_[GetEdge(edge_id).to] = Status::OnThePath;
+        GetEdge(edge_id).delta -= GetFlowUnit();
+        GetReverseEdge(edge_id).delta += GetFlowUnit();
+        MarkVertex(GetEdge(edge_id).to, Status::OnThePath);
         updated_edge_ = std::string::npos;
         flow_observable_.Notify();
     }
-    pushed_flow_ += (1 << flow_rate_);
+    pushed_flow_ += GetFlowUnit();
     network_observable_.Notify();
 }
 
@@ -214,55 +860,112 @@ const MaxFlow::Edge& MaxFlow::GetReverseEdge(size_t index) const {
     return edges_[index ^ 1];
 }
 
+size_t MaxFlow::GetFlowRate(size_t capacity) {
+    return capacity > 1 ? std::min<size_t>(std::bit_width(capacity - 1), kMaxFlowRate) : 0;
+}
+
+size_t MaxFlow::GetFlowUnit() const {
+    return size_t{1} << flow_rate_;
+}
+
 void MaxFlow::ResetState() {
     for (auto& vertex_status : vertices_) {
         vertex_status = Status::Basic;
     }
+    marked_vertices_.clear();
+    marked_edges_.clear();
     flow_rate_ = 0;
-    for (auto& edge : edges_) {
-        edge.status = Status::Basic;
-        while ((1u << flow_rate_) < edge.delta) {
-            flow_rate_++;
-        }
+    for (size_t i = 0; i < edges_.size(); i++) {
+        edges_[i].status = Status::Basic;
+        edges_[i].delta = capacities_[i];
+        flow_rate_ = std::max(flow_rate_, GetFlowRate(edges_[i].delta));
     }
     updated_edge_ = std::string::npos;
     pushed_flow_ = 0;
     network_observable_.Notify();
 }
 
-void MaxFlow::AddEdges(std::initializer_list<BasicEdge> edges) {
+void MaxFlow::AddEdges(const std::vector<BasicEdge>& edges) {
     edges_.reserve(m_ << 1);
     for (auto [u, to, delta] : edges) {
         edges_.push_back({.u = u, .to = to, .delta = delta});
         edges_.push_back({.u = to, .to = u, .delta = 0});
-        graph_[u].push_back(edges_.size() - 2);
-        graph_[to].push_back(edges_.size() - 1);
+        capacities_.push_back(delta);
+        capacities_.push_back(0);
+        costs_.push_back(0);
+        costs_.push_back(0);
+        flow_rate_ = std::max(flow_rate_, GetFlowRate(delta));
+    }
+    is_deleted_.resize(edges_.size() >> 1);
+    is_adjacency_actual_ = false;
+    is_edge_index_actual_ = false;
+}
+
+MaxFlow::MinCut MaxFlow::GetMinCut() {
+    BuildAdjacency();
+    MinCut cut;
+    cut.source_side.Assign(n_);
+    std::deque<size_t> queue(sources_.begin(), sources_.end());
+    for (size_t source : sources_) {
+        cut.source_side.Set(source);
+    }
+    while (!queue.empty()) {
+        size_t vertex = ExtractVertice(queue);
+        for (size_t i = adjacency_offsets_[vertex]; i < adjacency_offsets_[vertex + 1]; i++) {
+            const Edge& edge = GetEdge(adjacency_[i]);
+            if (edge.delta && !cut.source_side.Test(edge.to)) {
+                cut.source_side.Set(edge.to);
+                queue.push_back(edge.to);
+            }
+        }
     }
+    for (size_t i = 0; i < edges_.size(); i++) {
+        if (capacities_[i] && cut.source_side.Test(edges_[i].u) &&
+            !cut.source_side.Test(edges_[i].to)) {
+            cut.edges.push_back({.u = edges_[i].u, .to = edges_[i].to, .delta = capacities_[i]});
+            cut.capacity += capacities_[i];
+        }
+    }
+    return cut;
 }
 
 const MaxFlow::Data& MaxFlow::GetData() {
-    message_ =  Data{.edges = edges_,
+    message_ =  Data{.edges = {},
             .vertices = vertices_,
             .updated_edge = updated_edge_,
             .flow_rate = flow_rate_,
             .pushed_flow = pushed_flow_};
+    if (!deleted_edges_) {
+        message_.edges = edges_;
+        return message_;
+    }
+    message_.edges.reserve(m_ << 1);
+    for (size_t i = 0; i < edges_.size(); i++) {
+        if (!is_deleted_[i >> 1]) {
+            message_.edges.push_back(edges_[i]);
+        }
+    }
     return message_;
 }
 
 void MaxFlow::RegisterNetworkObserver(MaxFlow::DataObserverPtr observer) {
-    assert(network_observable_.Subscribe(observer));
+    [[maybe_unused]] bool is_subscribed = network_observable_.Subscribe(observer);
+    assert(is_subscribed);
 }
 
 void MaxFlow::RegisterFlowObserver(MaxFlow::DataObserverPtr observer) {
-    assert(flow_observable_.Subscribe(observer));
+    [[maybe_unused]] bool is_subscribed = flow_observable_.Subscribe(observer);
+    assert(is_subscribed);
 }
 
 void MaxFlow::RegisterCleanupObserver(MaxFlow::EmptyObserverPtr observer) {
-    assert(cleanup_observable_.Subscribe(observer));
+    [[maybe_unused]] bool is_subscribed = cleanup_observable_.Subscribe(observer);
+    assert(is_subscribed);
 }
 
 void MaxFlow::RegisterUnlockObserver(MaxFlow::EmptyObserverPtr observer) {
-    assert(unlock_observable_.Subscribe(observer));
+    [[maybe_unused]] bool is_subscribed = unlock_observable_.Subscribe(observer);
+    assert(is_subscribed);
 }
 
 void MaxFlow::ChangeVerticesNumberRequest(size_t new_number) {
@@ -270,20 +973,26 @@ void MaxFlow::ChangeVerticesNumberRequest(size_t new_number) {
     vertices_.resize(new_number, Status::Basic);
     if (new_number < n_) {
         std::vector<Edge> new_edges;
-        std::vector<std::vector<size_t>> new_graph(new_number);
-        for (const auto& edge : edges_) {
-            if (edge.u < new_number && edge.to < new_number) {
-                new_graph[edge.u].push_back(new_edges.size());
-                new_edges.push_back(edge);
+        std::vector<size_t> new_capacities;
+        std::vector<int64_t> new_costs;
+        for (size_t i = 0; i < edges_.size(); i++) {
+            if (!is_deleted_[i >> 1] && edges_[i].u < new_number && edges_[i].to < new_number) {
+                new_edges.push_back(edges_[i]);
+                new_capacities.push_back(capacities_[i]);
+                new_costs.push_back(costs_[i]);
             }
         }
         m_ = (new_edges.size() >> 1);
-        graph_ = std::move(new_graph);
         edges_ = std::move(new_edges);
-    } else {
-        graph_.resize(new_number);
+        capacities_ = std::move(new_capacities);
+        costs_ = std::move(new_costs);
+        is_deleted_.assign(m_, false);
+        deleted_edges_ = 0;
+        is_edge_index_actual_ = false;
     }
     n_ = new_number;
+    is_adjacency_actual_ = false;
+    ResetTerminals();
     ResetState();
 }
 
@@ -291,17 +1000,27 @@ size_t MaxFlow::GenRandNum(size_t l, size_t r) {
     return rand_generator_() % (r - l + 1) + l;
 }
 
-void MaxFlow::AddEdge(const BasicEdge& edge) {
+void MaxFlow::AddEdge(const BasicEdge& edge, int64_t cost) {
     size_t index = FindEdge(edge);
-    if (index == std::string::npos) {
+    if (index == std::string::npos || costs_[index] != cost) {
         edges_.push_back({.u = edge.u, .to = edge.to, .delta = edge.delta});
         edges_.push_back({.u = edge.to, .to = edge.u, .delta = 0});
-        graph_[edge.u].push_back(m_ << 1);
-        graph_[edge.to].push_back((m_ << 1) + 1);
+        next_same_arcs_.resize(edges_.size(), std::string::npos);
+        prev_same_arcs_.resize(edges_.size(), std::string::npos);
+        AppendToEdgeIndex(edges_.size() - 2);
+        AppendToEdgeIndex(edges_.size() - 1);
+        is_deleted_.push_back(false);
+        capacities_.push_back(edge.delta);
+        capacities_.push_back(0);
+        costs_.push_back(cost);
+        costs_.push_back(-cost);
+        is_adjacency_actual_ = false;
         m_++;
         return;
     }
+    RecordArc(index);
     edges_[index].delta += edge.delta;
+    capacities_[index] += edge.delta;
 }
 
 void MaxFlow::GenRandomSampleRequest() {
@@ -309,20 +1028,40 @@ void MaxFlow::GenRandomSampleRequest() {
     n_ = GenRandNum(kMinVerticesNum, kMaxVerticesNum);
     m_ = 0;
     edges_.clear();
-    graph_.clear();
-    graph_.resize(n_);
+    capacities_.clear();
+    costs_.clear();
+    is_adjacency_actual_ = false;
+    edge_index_.clear();
+    next_same_arcs_.clear();
+    prev_same_arcs_.clear();
+    is_deleted_.clear();
+    deleted_edges_ = 0;
     vertices_.resize(n_);
     for (size_t i = 1; i < n_; i++) {
         AddEdge({.u = GenRandNum(0, i - 1), .to = i, .delta = GenRandNum(1, kMaxEdgeCapacity)});
     }
+    ResetTerminals();
     ResetState();
 }
 
 void MaxFlow::SetEdgeStatus(size_t index, Status status) {
-    Edge& edge = GetEdge(index);
-    vertices_[edge.u] = status;
-    edge.status = status;
-    vertices_[edge.to] = status;
+    MarkVertex(GetEdge(index).u, status);
+    MarkEdge(index, status);
+    MarkVertex(GetEdge(index).to, status);
+}
+
+void MaxFlow::MarkVertex(size_t vertex, Status status) {
+    if (vertices_[vertex] == Status::Basic) {
+        marked_vertices_.push_back(vertex);
+    }
+    vertices_[vertex] = status;
+}
+
+void MaxFlow::MarkEdge(size_t index, Status status) {
+    if (edges_[index].status == Status::Basic) {
+        marked_edges_.push_back(index);
+    }
+    edges_[index].status = status;
 }
 
 void MaxFlow::SetPathToBasicStatus(const std::vector<size_t>& path) {
@@ -334,12 +1073,14 @@ void MaxFlow::SetPathToBasicStatus(const std::vector<size_t>& path) {
 }
 
 void MaxFlow::SetGraphToBasicStatus(bool is_flow_notification) {
-    for (Status& status : vertices_) {
-        status = Status::Basic;
+    for (size_t vertex : marked_vertices_) {
+        vertices_[vertex] = Status::Basic;
     }
-    for (Edge& edge : edges_) {
-        edge.status = Status::Basic;
+    for (size_t index : marked_edges_) {
+        edges_[index].status = Status::Basic;
     }
+    marked_vertices_.clear();
+    marked_edges_.clear();
     updated_edge_ = std::string::npos;
     if (is_flow_notification) {
         flow_observable_.Notify();
@@ -349,33 +1090,121 @@ void MaxFlow::SetGraphToBasicStatus(bool is_flow_notification) {
 }
 
 void MaxFlow::SaveState() {
-    State state{.n = n_, .m = m_, .flow_rate = flow_rate_, .graph = graph_};
-    std::vector<BasicEdge> edges;
-    for (auto [u, to, delta, _] : edges_) {
-        edges.push_back({u, to, delta});
+    previous_states_.push_back({.n = n_,
+                                .m = m_,
+                                .flow_rate = flow_rate_,
+                                .pushed_flow = pushed_flow_,
+                                .snapshot = Snapshot{.edges = edges_,
+                                                     .capacities = capacities_,
+                                                     .costs = costs_,
+                                                     .is_deleted = is_deleted_,
+                                                     .deleted_edges = deleted_edges_,
+                                                     .sources = sources_,
+                                                     .sinks = sinks_},
+                                .arcs_number = edges_.size(),
+                                .arcs = {},
+                                .deleted_arcs = {}});
+    while (previous_states_.size() > kStatesStorageSize) {
+        previous_states_.pop_front();
     }
-    state.edges = std::move(edges);
-    previous_states_.push_back(std::move(state));
+}
+
+void MaxFlow::SaveEditState() {
+    previous_states_.push_back({.n = n_,
+                                .m = m_,
+                                .flow_rate = flow_rate_,
+                                .pushed_flow = pushed_flow_,
+                                .snapshot = std::nullopt,
+                                .arcs_number = edges_.size(),
+                                .arcs = {},
+                                .deleted_arcs = {}});
     while (previous_states_.size() > kStatesStorageSize) {
         previous_states_.pop_front();
     }
 }
 
+bool MaxFlow::IsEditRecorded() const {
+    return !previous_states_.empty() && !previous_states_.back().snapshot;
+}
+
+void MaxFlow::RecordArc(size_t index) {
+    if (IsEditRecorded() && index < previous_states_.back().arcs_number) {
+        previous_states_.back().arcs.push_back(
+            {.index = index, .delta = edges_[index].delta, .capacity = capacities_[index]});
+    }
+}
+
+void MaxFlow::UndoEdits() {
+    const State& state = previous_states_.back();
+    if (edges_.size() > state.arcs_number) {
+        for (size_t i = edges_.size(); is_edge_index_actual_ && i > state.arcs_number; i--) {
+            RemoveFromEdgeIndex(i - 1);
+        }
+        edges_.resize(state.arcs_number);
+        capacities_.resize(state.arcs_number);
+        costs_.resize(state.arcs_number);
+        is_deleted_.resize(state.arcs_number >> 1);
+        if (is_edge_index_actual_) {
+            next_same_arcs_.resize(state.arcs_number);
+            prev_same_arcs_.resize(state.arcs_number);
+        }
+        is_adjacency_actual_ = false;
+    }
+    for (auto it = state.deleted_arcs.rbegin(); it != state.deleted_arcs.rend(); it++) {
+        is_deleted_[it->index >> 1] = false;
+        if (is_edge_index_actual_) {
+            RestoreToEdgeIndex(it->index, it->prev, it->next);
+        }
+    }
+    deleted_edges_ -= state.deleted_arcs.size() >> 1;
+    for (auto it = state.arcs.rbegin(); it != state.arcs.rend(); it++) {
+        edges_[it->index].delta = it->delta;
+        capacities_[it->index] = it->capacity;
+    }
+}
+
+void MaxFlow::BuildAdjacency() {
+    if (is_adjacency_actual_) {
+        return;
+    }
+    adjacency_offsets_.assign(n_ + 1, 0);
+    for (const auto& edge : edges_) {
+        adjacency_offsets_[edge.u + 1]++;
+    }
+    for (size_t i = 0; i < n_; i++) {
+        adjacency_offsets_[i + 1] += adjacency_offsets_[i];
+    }
+    adjacency_.resize(edges_.size());
+    std::vector<size_t> positions(adjacency_offsets_.begin(), adjacency_offsets_.end() - 1);
+    for (size_t i = 0; i < edges_.size(); i++) {
+        adjacency_[positions[edges_[i].u]++] = i;
+    }
+    is_adjacency_actual_ = true;
+}
+
 void MaxFlow::RecoverPrevStateRequest() {
     if (previous_states_.empty()) {
         return;
     }
+    if (!previous_states_.back().snapshot) {
+        UndoEdits();
+    }
     State state = std::move(previous_states_.back());
     previous_states_.pop_back();
     n_ = state.n;
     m_ = state.m;
     flow_rate_ = state.flow_rate;
-    pushed_flow_ = 0;
-    graph_ = std::move(state.graph);
-    edges_.clear();
-    vertices_.resize(n_);
-    for (auto [u, to, delta] : state.edges) {
-        edges_.push_back({.u = u, .to = to, .delta = delta, .status = Status::Basic});
+    pushed_flow_ = state.pushed_flow;
+    if (state.snapshot) {
+        edges_ = std::move(state.snapshot->edges);
+        capacities_ = std::move(state.snapshot->capacities);
+        costs_ = std::move(state.snapshot->costs);
+        is_deleted_ = std::move(state.snapshot->is_deleted);
+        deleted_edges_ = state.snapshot->deleted_edges;
+        is_adjacency_actual_ = false;
+        is_edge_index_actual_ = false;
+        vertices_.resize(n_);
+        SetTerminals(std::move(state.snapshot->sources), std::move(state.snapshot->sinks));
     }
     network_observable_.Notify();
     cleanup_observable_.Notify();
@@ -5,25 +5,53 @@
 #include <deque>
 #include "Library/observer_pattern.h"
 #include "kernel_messages.h"
+#include "residual_network.h"
+#include "push_relabel.h"
+#include "parallel_push_relabel.h"
+#include "boykov_kolmogorov.h"
+#include "dinic.h"
+#include "min_cost_flow.h"
+#include "hopcroft_karp.h"
+#include "network_reduction.h"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <random>
+#include <stop_token>
+#include <unordered_map>
+#include <utility>
 
 namespace max_flow_app {
 class MaxFlow {
 public:
     using BasicEdge = kernel_messages::BasicEdge;
+    using Engine = kernel_messages::Engine;
     using Data = kernel_messages::MaxFlowData;
+    using MinCut = kernel_messages::MinCut;
+    using SolveResult = kernel_messages::SolveResult;
+    using Clock = std::chrono::steady_clock;
     using DataObserverPtr = observer_pattern::Observer<Data>*;
     using EmptyObserverPtr = observer_pattern::Observer<void>*;
 
-    MaxFlow() = default;
+    MaxFlow();
     MaxFlow(size_t n, size_t m, std::initializer_list<BasicEdge> edges);
+    MaxFlow(size_t n, const std::vector<BasicEdge>& edges);
 
     void ChangeVerticesNumberRequest(size_t new_number);
-    void AddEdgeRequest(const BasicEdge& edge);
+    void AddEdgeRequest(const BasicEdge& edge, int64_t cost = 0);
     void DeleteEdgeRequest(const BasicEdge& egde);
-    void RunRequest();
+    void DeleteEdgesRequest(const std::vector<BasicEdge>& edges);
+    void RunRequest(Engine engine = Engine::Dinic);
+    SolveResult SolveRequest(std::stop_token stop_token,
+                             Clock::time_point deadline = Clock::time_point::max());
     void GenRandomSampleRequest();
     void RecoverPrevStateRequest();
+    void SetTerminalsRequest(size_t source, size_t sink);
+    void SetTerminalsRequest(const std::vector<size_t>& sources, const std::vector<size_t>& sinks);
+    MinCut GetMinCut();
+    int64_t GetFlowCost() const;
     void RegisterNetworkObserver(DataObserverPtr observer);
     void RegisterFlowObserver(DataObserverPtr observer);
     void RegisterCleanupObserver(EmptyObserverPtr observer);
@@ -34,48 +62,143 @@ private:
     using Status = kernel_messages::Status;
 
     const Data& GetData();
+    void RunDinic();
+    bool IsStopRequested();
+    size_t GetFlowUpperBound();
+    void RunEngine(Engine engine);
+    void RunMinCostFlow();
+    bool IsMatchingNetwork() const;
+    void RunMatching();
+    bool IsMultiTerminal() const;
+    size_t GetEngineVerticesNumber() const;
+    size_t GetEngineSource() const;
+    size_t GetEngineSink() const;
+    std::vector<BasicEdge> GetVirtualEdges() const;
+    std::vector<BasicEdge> GetEngineEdges() const;
+    bool IsFlowEmpty() const;
+    void SetTerminals(std::vector<size_t> sources, std::vector<size_t> sinks);
+    void ResetTerminals();
+    void LoadNetwork();
+    void StoreNetwork();
+    bool LoadReducedNetwork();
+    void StoreReducedNetwork();
     bool FindNetwork();
     void SetPathToBasicStatus(const std::vector<size_t>& path);
     void SetGraphToBasicStatus(bool is_flow_notification);
-    void ExtendNetwork(size_t vertex, std::vector<bool>& used, std::vector<ssize_t>& parent,
-                       std::deque<size_t>& queue);
-    void ChangeNewEdgeStatus(size_t vertex, const std::vector<ssize_t>& parent);
+    void ExtendNetwork(size_t vertex, std::deque<size_t>& queue);
+    void ChangeNewEdgeStatus(size_t vertex);
+    bool IsVisited(size_t vertex) const;
+    void Visit(size_t vertex, size_t dist, ssize_t parent);
+    void ResizeVisitBuffers();
     size_t ExtractVertice(std::deque<size_t>& queue);
-    void FindingNetworkInit(std::deque<size_t>& queue, std::vector<ssize_t>& parent,
-                            std::vector<bool>& used);
-    bool FindPath(size_t vertex, std::vector<size_t>& path);
+    void FindingNetworkInit(std::deque<size_t>& queue);
+    bool IsAdmissible(size_t edge_id) const;
+    bool FindPath(std::vector<size_t>& path);
+    void RetreatPath(std::vector<size_t>& path);
     void ProcessPath(const std::vector<size_t>& path);
     Edge& GetEdge(size_t index);
     Edge& GetReverseEdge(size_t index);
     const Edge& GetEdge(size_t index) const;
     const Edge& GetReverseEdge(size_t index) const;
-    void AddEdges(std::initializer_list<BasicEdge> edges);
-    void AddEdge(const BasicEdge& edge);
+    void AddEdges(const std::vector<BasicEdge>& edges);
+    void AddEdge(const BasicEdge& edge, int64_t cost = 0);
     size_t FindEdge(const BasicEdge& edge);
+    void BuildEdgeIndex();
+    void AppendToEdgeIndex(size_t index);
+    void RemoveFromEdgeIndex(size_t index);
+    void RestoreToEdgeIndex(size_t index, size_t prev, size_t next);
+    bool DeleteEdge(const BasicEdge& edge, size_t& lost_flow);
+    void CompactEdges();
+    size_t RepairFlow(size_t index);
+    size_t PushFlow(const std::vector<size_t>& from, const std::vector<size_t>& to,
+                    size_t limit);
     void SetEdgeStatus(size_t index, Status status);
+    void MarkVertex(size_t vertex, Status status);
+    void MarkEdge(size_t index, Status status);
     bool IsValid(const BasicEdge& edge);
     void ResetState();
+    static size_t GetFlowRate(size_t capacity);
+    size_t GetFlowUnit() const;
     void SaveState();
+    void SaveEditState();
+    bool IsEditRecorded() const;
+    void RecordArc(size_t index);
+    void UndoEdits();
+    void BuildAdjacency();
     size_t GenRandNum(size_t l, size_t r);
 
+    struct EdgeKeyHash {
+        size_t operator()(const std::pair<size_t, size_t>& key) const {
+            return std::hash<size_t>()(key.first * 0x9E3779B97F4A7C15ull ^ key.second);
+        }
+    };
+
+    struct ArcChain {
+        size_t first, last;
+    };
+
+    struct Snapshot {
+        std::vector<Edge> edges;
+        std::vector<size_t> capacities;
+        std::vector<int64_t> costs;
+        std::vector<bool> is_deleted;
+        size_t deleted_edges;
+        std::vector<size_t> sources, sinks;
+    };
+
+    struct ArcRecord {
+        size_t index, delta, capacity;
+    };
+
+    struct DeletedArc {
+        size_t index, prev, next;
+    };
+
+    // Edit requests keep inverse operations instead of a snapshot: arcs appended after
+    // arcs_number, the previous deltas and capacities and the arcs they tombstoned.
     struct State {
-        size_t n, m, flow_rate = 0;
-        std::vector<std::vector<size_t>> graph;
-        std::vector<BasicEdge> edges;
+        size_t n, m, flow_rate = 0, pushed_flow = 0;
+        std::optional<Snapshot> snapshot;
+        size_t arcs_number = 0;
+        std::vector<ArcRecord> arcs;
+        std::vector<DeletedArc> deleted_arcs;
     };
 
     static constexpr size_t kMinVerticesNum = 2;
     static constexpr size_t kMaxVerticesNum = 10;
     static constexpr size_t kMaxEdgeCapacity = 100;
     static constexpr size_t kStatesStorageSize = 10;
+    static constexpr size_t kMaxFlowRate = std::numeric_limits<size_t>::digits - 1;
+    static constexpr size_t kStopCheckPeriod = 1024;
     size_t n_ = 2, m_ = 0;
-    std::vector<std::vector<size_t>> graph_ = std::vector<std::vector<size_t>>(n_);
+    std::vector<size_t> adjacency_offsets_ = std::vector<size_t>(n_ + 1);
+    std::vector<size_t> adjacency_;
+    bool is_adjacency_actual_ = true;
+    std::unordered_map<std::pair<size_t, size_t>, ArcChain, EdgeKeyHash> edge_index_;
+    std::vector<size_t> next_same_arcs_;
+    std::vector<size_t> prev_same_arcs_;
+    bool is_edge_index_actual_ = true;
+    std::vector<bool> is_deleted_;
+    size_t deleted_edges_ = 0;
+    std::vector<size_t> visit_stamps_;
+    size_t visit_stamp_ = 0;
+    bitset::DynamicBitset is_push_target_;
     std::vector<size_t> dist_ = std::vector<size_t>(n_);
+    std::vector<ssize_t> parent_ = std::vector<ssize_t>(n_);
     std::vector<size_t> processed_neighbors_ = std::vector<size_t>(n_);
     std::vector<Edge> edges_;
+    std::vector<size_t> capacities_;
+    std::vector<int64_t> costs_;
     std::vector<Status> vertices_ = std::vector<Status>(n_, Status::Basic);
+    std::vector<size_t> marked_vertices_, marked_edges_;
+    std::vector<size_t> sources_, sinks_;
+    bitset::DynamicBitset is_sink_;
+    size_t current_source_ = 0;
     size_t updated_edge_ = std::string::npos;
     size_t flow_rate_ = 0, pushed_flow_ = 0;
+    std::stop_token stop_token_;
+    Clock::time_point deadline_ = Clock::time_point::max();
+    bool is_stopped_ = false;
     Data message_;
     observer_pattern::Observable<Data> network_observable_ =
         observer_pattern::Observable<Data>([this]() -> const Data& { return GetData(); });
@@ -85,6 +208,16 @@ private:
     observer_pattern::Observable<void> unlock_observable_;
     std::mt19937 rand_generator_;
     std::deque<State> previous_states_;
+    ResidualNetwork network_;
+    PushRelabel push_relabel_;
+    std::unique_ptr<ParallelPushRelabel> parallel_push_relabel_;
+    BoykovKolmogorov boykov_kolmogorov_;
+    Dinic<size_t> direction_optimizing_dinic_ =
+        Dinic<size_t>(LevelGraphBuilder::DirectionOptimizing);
+    std::unique_ptr<Dinic<size_t>> parallel_dinic_;
+    MinCostFlow min_cost_flow_;
+    HopcroftKarp hopcroft_karp_;
+    NetworkReduction reduction_;
 };
 
 }  // namespace max_flow_app
@@ -0,0 +1,122 @@
+#include "min_cost_flow.h"
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace max_flow_app {
+std::optional<size_t> MinCostFlow::Run(size_t n, std::vector<Edge>& edges,
+                                       const std::vector<int64_t>& costs, size_t source,
+                                       size_t sink) {
+    assert(source != sink && edges.size() == costs.size());
+    BuildAdjacency(n, edges);
+    if (!InitPotentials(edges, costs, source)) {
+        return std::nullopt;
+    }
+    size_t flow = 0;
+    while (FindPath(edges, costs, source, sink)) {
+        flow += Augment(edges, source, sink);
+    }
+    return flow;
+}
+
+void MinCostFlow::BuildAdjacency(size_t n, const std::vector<Edge>& edges) {
+    n_ = n;
+    offsets_.assign(n_ + 1, 0);
+    for (const auto& edge : edges) {
+        offsets_[edge.u + 1]++;
+    }
+    for (size_t i = 0; i < n_; i++) {
+        offsets_[i + 1] += offsets_[i];
+    }
+    adjacency_.resize(edges.size());
+    std::vector<size_t> positions(offsets_.begin(), offsets_.end() - 1);
+    for (size_t i = 0; i < edges.size(); i++) {
+        adjacency_[positions[edges[i].u]++] = i;
+    }
+}
+
+bool MinCostFlow::InitPotentials(const std::vector<Edge>& edges,
+                                 const std::vector<int64_t>& costs, size_t source) {
+    potentials_.assign(n_, kInfiniteDistance);
+    potentials_[source] = 0;
+    std::vector<size_t> relaxations(n_);
+    std::vector<bool> is_queued(n_);
+    std::deque<size_t> queue = {source};
+    while (!queue.empty()) {
+        size_t vertex = queue.front();
+        queue.pop_front();
+        is_queued[vertex] = false;
+        for (size_t i = offsets_[vertex]; i < offsets_[vertex + 1]; i++) {
+            const Edge& edge = edges[adjacency_[i]];
+            int64_t distance = potentials_[vertex] + costs[adjacency_[i]];
+            if (!edge.delta || distance >= potentials_[edge.to]) {
+                continue;
+            }
+            potentials_[edge.to] = distance;
+            if (!is_queued[edge.to]) {
+                if (++relaxations[edge.to] == n_) {
+                    return false;
+                }
+                is_queued[edge.to] = true;
+                queue.push_back(edge.to);
+            }
+        }
+    }
+    return true;
+}
+
+bool MinCostFlow::FindPath(const std::vector<Edge>& edges, const std::vector<int64_t>& costs,
+                           size_t source, size_t sink) {
+    using Item = std::pair<int64_t, size_t>;
+    distances_.assign(n_, kInfiniteDistance);
+    parents_.resize(n_);
+    distances_[source] = 0;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    queue.push({0, source});
+    while (!queue.empty()) {
+        auto [distance, vertex] = queue.top();
+        queue.pop();
+        if (distance != distances_[vertex]) {
+            continue;
+        }
+        for (size_t i = offsets_[vertex]; i < offsets_[vertex + 1]; i++) {
+            size_t index = adjacency_[i];
+            const Edge& edge = edges[index];
+            if (!edge.delta) {
+                continue;
+            }
+            int64_t reduced_cost = costs[index] + potentials_[vertex] - potentials_[edge.to];
+            assert(reduced_cost >= 0);
+            if (distance + reduced_cost < distances_[edge.to]) {
+                distances_[edge.to] = distance + reduced_cost;
+                parents_[edge.to] = index;
+                queue.push({distances_[edge.to], edge.to});
+            }
+        }
+    }
+    if (distances_[sink] == kInfiniteDistance) {
+        return false;
+    }
+    for (size_t vertex = 0; vertex < n_; vertex++) {
+        if (distances_[vertex] != kInfiniteDistance) {
+            potentials_[vertex] += distances_[vertex];
+        }
+    }
+    return true;
+}
+
+size_t MinCostFlow::Augment(std::vector<Edge>& edges, size_t source, size_t sink) {
+    size_t flow = edges[parents_[sink]].delta;
+    for (size_t vertex = sink; vertex != source; vertex = edges[parents_[vertex]].u) {
+        flow = std::min(flow, edges[parents_[vertex]].delta);
+    }
+    for (size_t vertex = sink; vertex != source; vertex = edges[parents_[vertex]].u) {
+        edges[parents_[vertex]].delta -= flow;
+        edges[parents_[vertex] ^ 1].delta += flow;
+    }
+    return flow;
+}
+}  // namespace max_flow_app
@@ -0,0 +1,35 @@
+#ifndef MIN_COST_FLOW_H
+#define MIN_COST_FLOW_H
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+#include "kernel_messages.h"
+
+namespace max_flow_app {
+class MinCostFlow {
+public:
+    using Edge = kernel_messages::Edge;
+
+    std::optional<size_t> Run(size_t n, std::vector<Edge>& edges,
+                              const std::vector<int64_t>& costs, size_t source, size_t sink);
+
+private:
+    void BuildAdjacency(size_t n, const std::vector<Edge>& edges);
+    bool InitPotentials(const std::vector<Edge>& edges, const std::vector<int64_t>& costs,
+                        size_t source);
+    bool FindPath(const std::vector<Edge>& edges, const std::vector<int64_t>& costs,
+                  size_t source, size_t sink);
+    size_t Augment(std::vector<Edge>& edges, size_t source, size_t sink);
+
+    static constexpr int64_t kInfiniteDistance = std::numeric_limits<int64_t>::max();
+    size_t n_ = 0;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> adjacency_;
+    std::vector<int64_t> potentials_;
+    std::vector<int64_t> distances_;
+    std::vector<size_t> parents_;
+};
+}  // namespace max_flow_app
+#endif  // MIN_COST_FLOW_H
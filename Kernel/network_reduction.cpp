@@ -0,0 +1,329 @@
+#include "network_reduction.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+
+namespace max_flow_app {
+bool NetworkReduction::IsWorthwhile(size_t n, const std::vector<BasicEdge>& edges, size_t source,
+                                    size_t sink) {
+    std::vector<size_t> in_degrees(n), out_degrees(n);
+    for (const auto& edge : edges) {
+        if (edge.delta && edge.u != edge.to) {
+            out_degrees[edge.u]++;
+            in_degrees[edge.to]++;
+        }
+    }
+    size_t reducible = 0;
+    for (size_t vertex = 0; vertex < n; vertex++) {
+        if (vertex != source && vertex != sink &&
+            (!in_degrees[vertex] || !out_degrees[vertex] ||
+             (in_degrees[vertex] == 1 && out_degrees[vertex] == 1))) {
+            reducible++;
+        }
+    }
+    return reducible * kMinReducibleShare >= n;
+}
+
+void NetworkReduction::Build(size_t n, const std::vector<BasicEdge>& edges, size_t source,
+                             size_t sink) {
+    assert(source < n && sink < n && source != sink);
+    n_ = n;
+    source_ = source;
+    sink_ = sink;
+    original_number_ = edges.size();
+    nodes_.clear();
+    nodes_.reserve(2 * original_number_);
+    replacements_.clear();
+    replacements_.reserve(2 * original_number_);
+    alive_nodes_.clear();
+    size_t keys_number = n_;
+    for (const auto& edge : edges) {
+        keys_number += edge.delta && edge.u != edge.to;
+    }
+    key_slots_.assign(std::bit_ceil(2 * keys_number), kNone);
+    key_shift_ = std::numeric_limits<size_t>::digits - std::countr_zero(key_slots_.size());
+    for (const auto& edge : edges) {
+        AddNode(edge, Kind::Original, kNone, kNone);
+    }
+    for (size_t i = 0; i < original_number_; i++) {
+        if (!edges[i].delta || edges[i].u == edges[i].to) {
+            replacements_[i] = kNone;
+        }
+    }
+    BuildAdjacency();
+    candidates_.resize(n_);
+    for (size_t vertex = 0; vertex < n_; vertex++) {
+        candidates_[vertex] = vertex;
+    }
+    for (size_t i = 0; i < original_number_; i++) {
+        if (replacements_[i] == i) {
+            MergeParallel(i);
+        }
+    }
+    Simplify();
+    while (Prune()) {
+        Simplify();
+    }
+    Compact();
+}
+
+size_t NetworkReduction::GetVerticesNumber() const {
+    return reduced_n_;
+}
+
+size_t NetworkReduction::GetSource() const {
+    return 0;
+}
+
+size_t NetworkReduction::GetSink() const {
+    return 1;
+}
+
+const std::vector<NetworkReduction::BasicEdge>& NetworkReduction::GetEdges() const {
+    return reduced_edges_;
+}
+
+std::vector<size_t> NetworkReduction::RestoreFlows(const std::vector<size_t>& flows) const {
+    assert(flows.size() == reduced_nodes_.size());
+    std::vector<size_t> node_flows(nodes_.size());
+    for (size_t i = 0; i < flows.size(); i++) {
+        node_flows[reduced_nodes_[i]] = flows[i];
+    }
+    for (size_t i = nodes_.size(); i-- > original_number_;) {
+        const auto& node = nodes_[i];
+        if (node.kind == Kind::Series) {
+            node_flows[node.first] = node_flows[node.second] = node_flows[i];
+        } else {
+            node_flows[node.first] = std::min(node_flows[i], nodes_[node.first].edge.delta);
+            node_flows[node.second] = node_flows[i] - node_flows[node.first];
+        }
+    }
+    node_flows.resize(original_number_);
+    return node_flows;
+}
+
+void NetworkReduction::BuildAdjacency() {
+    in_offsets_.assign(n_ + 1, 0);
+    out_offsets_.assign(n_ + 1, 0);
+    for (size_t i = 0; i < original_number_; i++) {
+        if (replacements_[i] == i) {
+            in_offsets_[nodes_[i].edge.to + 1]++;
+            out_offsets_[nodes_[i].edge.u + 1]++;
+        }
+    }
+    in_degrees_.assign(in_offsets_.begin() + 1, in_offsets_.end());
+    out_degrees_.assign(out_offsets_.begin() + 1, out_offsets_.end());
+    for (size_t vertex = 0; vertex < n_; vertex++) {
+        in_offsets_[vertex + 1] += in_offsets_[vertex];
+        out_offsets_[vertex + 1] += out_offsets_[vertex];
+    }
+    in_nodes_.resize(in_offsets_[n_]);
+    out_nodes_.resize(out_offsets_[n_]);
+    std::vector<size_t> in_positions(in_offsets_.begin(), in_offsets_.end() - 1);
+    std::vector<size_t> out_positions(out_offsets_.begin(), out_offsets_.end() - 1);
+    for (size_t i = 0; i < original_number_; i++) {
+        if (replacements_[i] == i) {
+            in_nodes_[in_positions[nodes_[i].edge.to]++] = i;
+            out_nodes_[out_positions[nodes_[i].edge.u]++] = i;
+        }
+    }
+}
+
+void NetworkReduction::Simplify() {
+    while (!candidates_.empty()) {
+        size_t vertex = candidates_.back();
+        candidates_.pop_back();
+        Reduce(vertex);
+    }
+}
+
+void NetworkReduction::Reduce(size_t vertex) {
+    if (vertex == source_ || vertex == sink_) {
+        return;
+    }
+    if (!in_degrees_[vertex] || !out_degrees_[vertex]) {
+        RemoveIncident(vertex, true);
+        RemoveIncident(vertex, false);
+        return;
+    }
+    if (in_degrees_[vertex] != 1 || out_degrees_[vertex] != 1) {
+        return;
+    }
+    size_t in = FindAlive(vertex, true), out = FindAlive(vertex, false);
+    size_t u = nodes_[in].edge.u, to = nodes_[out].edge.to;
+    if (u == to) {
+        Remove(in);
+        Remove(out);
+        candidates_.push_back(u);
+        return;
+    }
+    size_t node_id = AddNode({u, to, std::min(nodes_[in].edge.delta, nodes_[out].edge.delta)},
+                             Kind::Series, in, out);
+    in_degrees_[vertex] = out_degrees_[vertex] = 0;
+    MergeParallel(node_id);
+}
+
+void NetworkReduction::RemoveIncident(size_t vertex, bool is_incoming) {
+    const auto& offsets = is_incoming ? in_offsets_ : out_offsets_;
+    const auto& node_ids = is_incoming ? in_nodes_ : out_nodes_;
+    auto& degree = is_incoming ? in_degrees_[vertex] : out_degrees_[vertex];
+    for (size_t i = offsets[vertex]; degree && i < offsets[vertex + 1]; i++) {
+        size_t node_id = Resolve(node_ids[i]);
+        if (node_id != kNone) {
+            Remove(node_id);
+            candidates_.push_back(is_incoming ? nodes_[node_id].edge.u : nodes_[node_id].edge.to);
+        }
+    }
+}
+
+size_t NetworkReduction::FindAlive(size_t vertex, bool is_incoming) {
+    const auto& offsets = is_incoming ? in_offsets_ : out_offsets_;
+    const auto& node_ids = is_incoming ? in_nodes_ : out_nodes_;
+    for (size_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+        size_t node_id = Resolve(node_ids[i]);
+        if (node_id != kNone) {
+            assert((is_incoming ? nodes_[node_id].edge.to : nodes_[node_id].edge.u) == vertex);
+            return node_id;
+        }
+    }
+    assert(0);
+    return kNone;
+}
+
+size_t NetworkReduction::FindSlot(size_t u, size_t to) const {
+    const size_t multiplier = 0x9E3779B97F4A7C15ull;
+    size_t slot = ((u * multiplier + to) * multiplier) >> key_shift_;
+    while (key_slots_[slot] != kNone) {
+        const auto& edge = nodes_[key_slots_[slot]].edge;
+        if (edge.u == u && edge.to == to) {
+            break;
+        }
+        slot = (slot + 1) & (key_slots_.size() - 1);
+    }
+    return slot;
+}
+
+void NetworkReduction::MergeParallel(size_t node_id) {
+    auto [u, to, delta] = nodes_[node_id].edge;
+    size_t slot = FindSlot(u, to);
+    if (key_slots_[slot] == kNone || replacements_[key_slots_[slot]] != key_slots_[slot]) {
+        key_slots_[slot] = node_id;
+        return;
+    }
+    size_t other = key_slots_[slot];
+    key_slots_[slot] =
+        AddNode({u, to, nodes_[other].edge.delta + delta}, Kind::Parallel, other, node_id);
+    out_degrees_[u]--;
+    in_degrees_[to]--;
+    candidates_.push_back(u);
+    candidates_.push_back(to);
+}
+
+bool NetworkReduction::Prune() {
+    std::vector<bool> is_reached_from_source(n_), is_reaching_sink(n_);
+    Reach(source_, true, is_reached_from_source);
+    Reach(sink_, false, is_reaching_sink);
+    for (size_t node_id : grouped_nodes_) {
+        const auto& edge = nodes_[node_id].edge;
+        if (!(is_reached_from_source[edge.u] && is_reaching_sink[edge.to])) {
+            Remove(node_id);
+            candidates_.push_back(edge.u);
+            candidates_.push_back(edge.to);
+        }
+    }
+    return !candidates_.empty();
+}
+
+void NetworkReduction::Reach(size_t start, bool is_forward, std::vector<bool>& reached) {
+    GroupAliveNodes(is_forward);
+    std::vector<size_t> stack = {start};
+    reached[start] = true;
+    while (!stack.empty()) {
+        size_t vertex = stack.back();
+        stack.pop_back();
+        for (size_t i = group_offsets_[vertex]; i < group_offsets_[vertex + 1]; i++) {
+            const auto& edge = nodes_[grouped_nodes_[i]].edge;
+            size_t next = is_forward ? edge.to : edge.u;
+            if (!reached[next]) {
+                reached[next] = true;
+                stack.push_back(next);
+            }
+        }
+    }
+}
+
+void NetworkReduction::GroupAliveNodes(bool is_forward) {
+    std::erase_if(alive_nodes_,
+                  [this](size_t node_id) { return replacements_[node_id] != node_id; });
+    group_offsets_.assign(n_ + 1, 0);
+    for (size_t node_id : alive_nodes_) {
+        const auto& edge = nodes_[node_id].edge;
+        group_offsets_[(is_forward ? edge.u : edge.to) + 1]++;
+    }
+    for (size_t vertex = 0; vertex < n_; vertex++) {
+        group_offsets_[vertex + 1] += group_offsets_[vertex];
+    }
+    grouped_nodes_.resize(alive_nodes_.size());
+    for (size_t node_id : alive_nodes_) {
+        const auto& edge = nodes_[node_id].edge;
+        grouped_nodes_[group_offsets_[is_forward ? edge.u : edge.to]++] = node_id;
+    }
+    for (size_t vertex = n_; vertex > 0; vertex--) {
+        group_offsets_[vertex] = group_offsets_[vertex - 1];
+    }
+    group_offsets_[0] = 0;
+}
+
+size_t NetworkReduction::Resolve(size_t node_id) {
+    size_t root = node_id;
+    while (root != kNone && replacements_[root] != root) {
+        root = replacements_[root];
+    }
+    while (node_id != root) {
+        size_t next = replacements_[node_id];
+        replacements_[node_id] = root;
+        node_id = next;
+    }
+    return root;
+}
+
+size_t NetworkReduction::AddNode(const BasicEdge& edge, Kind kind, size_t first, size_t second) {
+    size_t node_id = nodes_.size();
+    nodes_.push_back({.edge = edge, .kind = kind, .first = first, .second = second});
+    replacements_.push_back(node_id);
+    alive_nodes_.push_back(node_id);
+    if (kind != Kind::Original) {
+        replacements_[first] = replacements_[second] = node_id;
+    }
+    return node_id;
+}
+
+void NetworkReduction::Remove(size_t node_id) {
+    assert(replacements_[node_id] == node_id);
+    replacements_[node_id] = kNone;
+    out_degrees_[nodes_[node_id].edge.u]--;
+    in_degrees_[nodes_[node_id].edge.to]--;
+}
+
+void NetworkReduction::Compact() {
+    std::vector<size_t> indices(n_, kNone);
+    indices[source_] = 0;
+    indices[sink_] = 1;
+    reduced_n_ = 2;
+    reduced_edges_.clear();
+    reduced_nodes_.clear();
+    std::erase_if(alive_nodes_,
+                  [this](size_t node_id) { return replacements_[node_id] != node_id; });
+    for (size_t node_id : alive_nodes_) {
+        auto [u, to, delta] = nodes_[node_id].edge;
+        for (size_t vertex : {u, to}) {
+            if (indices[vertex] == kNone) {
+                indices[vertex] = reduced_n_++;
+            }
+        }
+        reduced_edges_.push_back({indices[u], indices[to], delta});
+        reduced_nodes_.push_back(node_id);
+    }
+}
+}  // namespace max_flow_app
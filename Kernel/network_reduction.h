@@ -0,0 +1,64 @@
+#ifndef NETWORK_REDUCTION_H
+#define NETWORK_REDUCTION_H
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "kernel_messages.h"
+
+namespace max_flow_app {
+class NetworkReduction {
+public:
+    using BasicEdge = kernel_messages::BasicEdge;
+
+    static bool IsWorthwhile(size_t n, const std::vector<BasicEdge>& edges, size_t source,
+                             size_t sink);
+    void Build(size_t n, const std::vector<BasicEdge>& edges, size_t source, size_t sink);
+    size_t GetVerticesNumber() const;
+    size_t GetSource() const;
+    size_t GetSink() const;
+    const std::vector<BasicEdge>& GetEdges() const;
+    std::vector<size_t> RestoreFlows(const std::vector<size_t>& flows) const;
+
+private:
+    enum class Kind { Original, Series, Parallel };
+
+    struct Node {
+        BasicEdge edge;
+        Kind kind = Kind::Original;
+        size_t first = kNone, second = kNone;
+    };
+
+    void BuildAdjacency();
+    void Simplify();
+    void Reduce(size_t vertex);
+    void RemoveIncident(size_t vertex, bool is_incoming);
+    size_t FindAlive(size_t vertex, bool is_incoming);
+    size_t FindSlot(size_t u, size_t to) const;
+    void MergeParallel(size_t node_id);
+    bool Prune();
+    void Reach(size_t start, bool is_forward, std::vector<bool>& reached);
+    void GroupAliveNodes(bool is_forward);
+    size_t Resolve(size_t node_id);
+    size_t AddNode(const BasicEdge& edge, Kind kind, size_t first, size_t second);
+    void Remove(size_t node_id);
+    void Compact();
+
+    static constexpr size_t kNone = std::string::npos;
+    static constexpr size_t kMinReducibleShare = 8;
+    size_t n_ = 0, original_number_ = 0, source_ = 0, sink_ = 0;
+    std::vector<Node> nodes_;
+    std::vector<size_t> replacements_, alive_nodes_;
+    std::vector<size_t> in_offsets_, in_nodes_, out_offsets_, out_nodes_;
+    std::vector<size_t> in_degrees_, out_degrees_;
+    std::vector<size_t> group_offsets_, grouped_nodes_;
+    // Open addressing table of the last node added for each (u, to); a slot whose node is no
+    // longer alive is free. Each original edge and series node takes at most one slot.
+    std::vector<size_t> key_slots_;
+    size_t key_shift_ = 0;
+    std::vector<size_t> candidates_;
+    size_t reduced_n_ = 0;
+    std::vector<BasicEdge> reduced_edges_;
+    std::vector<size_t> reduced_nodes_;
+};
+}  // namespace max_flow_app
+#endif  // NETWORK_REDUCTION_H
@@ -0,0 +1,240 @@
+#include "parallel_push_relabel.h"
+#include <algorithm>
+#include <cassert>
+
+namespace max_flow_app {
+ParallelPushRelabel::ParallelPushRelabel(size_t threads_number)
+    : pool_(threads_number), next_active_(pool_.GetThreadsNumber()) {
+}
+
+size_t ParallelPushRelabel::GetThreadsNumber() const {
+    return pool_.GetThreadsNumber();
+}
+
+size_t ParallelPushRelabel::Run(ResidualNetwork& network, size_t source, size_t sink) {
+    assert(source != sink);
+    Init(network, source);
+    RunPhase(network, sink, source);
+    size_t flow = excess_[sink];
+    RunPhase(network, source, sink);
+    return flow;
+}
+
+void ParallelPushRelabel::Init(ResidualNetwork& network, size_t source) {
+    if (n_ != network.GetVerticesNumber()) {
+        n_ = network.GetVerticesNumber();
+        heights_ = std::vector<std::atomic<size_t>>(n_);
+        height_counts_ = std::vector<std::atomic<size_t>>(n_);
+        locks_ = std::vector<std::atomic<bool>>(n_);
+        is_queued_ = std::vector<std::atomic<bool>>(n_);
+    }
+    excess_.assign(n_, 0);
+    current_arcs_.resize(n_);
+    for (size_t i = network.Begin(source); i < network.End(source); i++) {
+        size_t residual = network.GetResidual(i);
+        excess_[network.GetHead(i)] += residual;
+        network.Push(i, residual);
+    }
+}
+
+void ParallelPushRelabel::RunPhase(ResidualNetwork& network, size_t target, size_t blocked) {
+    GlobalRelabel(network, target, blocked);
+    while (!active_.empty()) {
+        pool_.ParallelFor(
+            active_.size(),
+            [&](size_t index, size_t thread_id) {
+                Discharge(network, active_[index], target, blocked, next_active_[thread_id]);
+            },
+            kGrain);
+        MergeNextActive();
+        if (work_since_relabel_ > kGlobalRelabelFrequency * n_ + network.GetArcsNumber()) {
+            GlobalRelabel(network, target, blocked);
+        } else if (gap_height_ < n_ && work_since_relabel_ >= work_since_gap_mark_ + n_) {
+            ApplyGap();
+        }
+    }
+}
+
+void ParallelPushRelabel::GlobalRelabel(const ResidualNetwork& network, size_t target,
+                                        size_t blocked) {
+    pool_.ParallelFor(
+        n_,
+        [this](size_t vertex, size_t) {
+            heights_[vertex].store(n_, std::memory_order_relaxed);
+            height_counts_[vertex].store(0, std::memory_order_relaxed);
+            is_queued_[vertex].store(false, std::memory_order_relaxed);
+        },
+        kGrain);
+    heights_[target] = 0;
+    active_.assign(1, target);
+    for (size_t height = 1; !active_.empty(); height++) {
+        pool_.ParallelFor(
+            active_.size(),
+            [&](size_t index, size_t thread_id) {
+                size_t vertex = active_[index];
+                for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+                    size_t to = network.GetHead(i);
+                    size_t expected = n_;
+                    if (to != blocked && network.GetResidual(network.GetReverse(i)) &&
+                        heights_[to].compare_exchange_strong(expected, height,
+                                                             std::memory_order_relaxed)) {
+                        next_active_[thread_id].push_back(to);
+                    }
+                }
+            },
+            kGrain);
+        MergeNextActive();
+    }
+    for (size_t vertex = 0; vertex < n_; vertex++) {
+        current_arcs_[vertex] = network.Begin(vertex);
+        size_t height = heights_[vertex].load(std::memory_order_relaxed);
+        if (height < n_) {
+            height_counts_[height].fetch_add(1, std::memory_order_relaxed);
+        }
+        if (excess_[vertex] && vertex != target && vertex != blocked && height < n_) {
+            is_queued_[vertex] = true;
+            active_.push_back(vertex);
+        }
+    }
+    work_since_relabel_ = 0;
+    work_since_gap_mark_ = 0;
+    gap_height_ = n_;
+}
+
+void ParallelPushRelabel::ApplyGap() {
+    size_t gap = gap_height_.exchange(n_);
+    work_since_gap_mark_ = work_since_relabel_;
+    if (height_counts_[gap].load(std::memory_order_relaxed)) {
+        return;
+    }
+    pool_.ParallelFor(
+        n_,
+        [this, gap](size_t vertex, size_t) {
+            size_t height = heights_[vertex].load(std::memory_order_relaxed);
+            if (height > gap && height < n_) {
+                height_counts_[height].store(0, std::memory_order_relaxed);
+                heights_[vertex].store(n_, std::memory_order_relaxed);
+            }
+        },
+        kGrain);
+    std::erase_if(active_, [this](size_t vertex) {
+        if (heights_[vertex].load(std::memory_order_relaxed) < n_) {
+            return false;
+        }
+        is_queued_[vertex].store(false, std::memory_order_relaxed);
+        return true;
+    });
+}
+
+void ParallelPushRelabel::Discharge(ResidualNetwork& network, size_t vertex, size_t target,
+                                    size_t blocked, std::vector<size_t>& next) {
+    is_queued_[vertex].store(false, std::memory_order_relaxed);
+    if (!TryLock(vertex)) {
+        Enqueue(vertex, next);
+        return;
+    }
+    while (excess_[vertex]) {
+        if (current_arcs_[vertex] == network.End(vertex)) {
+            Relabel(network, vertex);
+            if (heights_[vertex].load(std::memory_order_relaxed) >= n_) {
+                break;
+            }
+            continue;
+        }
+        size_t index = current_arcs_[vertex];
+        size_t to = network.GetHead(index);
+        size_t height = heights_[vertex].load(std::memory_order_relaxed);
+        if (!network.GetResidual(index) ||
+            height != heights_[to].load(std::memory_order_relaxed) + 1) {
+            current_arcs_[vertex]++;
+            continue;
+        }
+        LockNeighbour(vertex, to);
+        if (!network.GetResidual(index) ||
+            height != heights_[to].load(std::memory_order_relaxed) + 1) {
+            Unlock(to);
+            continue;
+        }
+        size_t flow = std::min(excess_[vertex], network.GetResidual(index));
+        network.Push(index, flow);
+        excess_[vertex] -= flow;
+        bool is_activated = !excess_[to] && to != target && to != blocked;
+        excess_[to] += flow;
+        Unlock(to);
+        if (is_activated) {
+            Enqueue(to, next);
+        }
+    }
+    Unlock(vertex);
+}
+
+void ParallelPushRelabel::Relabel(const ResidualNetwork& network, size_t vertex) {
+    size_t old_height = heights_[vertex].load(std::memory_order_relaxed);
+    size_t new_height = n_;
+    for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+        if (network.GetResidual(i)) {
+            new_height = std::min(new_height,
+                                  heights_[network.GetHead(i)].load(std::memory_order_relaxed) + 1);
+        }
+    }
+    heights_[vertex].store(new_height, std::memory_order_relaxed);
+    if (new_height < n_) {
+        height_counts_[new_height].fetch_add(1, std::memory_order_relaxed);
+    }
+    if (old_height < n_ &&
+        height_counts_[old_height].fetch_sub(1, std::memory_order_relaxed) == 1) {
+        size_t gap = gap_height_.load(std::memory_order_relaxed);
+        while (old_height < gap &&
+               !gap_height_.compare_exchange_weak(gap, old_height, std::memory_order_relaxed)) {
+        }
+    }
+    current_arcs_[vertex] = network.Begin(vertex);
+    work_since_relabel_.fetch_add(
+        network.End(vertex) - network.Begin(vertex) + kGlobalRelabelFrequency,
+        std::memory_order_relaxed);
+}
+
+void ParallelPushRelabel::Enqueue(size_t vertex, std::vector<size_t>& next) {
+    if (!is_queued_[vertex].exchange(true, std::memory_order_relaxed)) {
+        next.push_back(vertex);
+    }
+}
+
+void ParallelPushRelabel::MergeNextActive() {
+    active_.clear();
+    for (auto& next : next_active_) {
+        active_.insert(active_.end(), next.begin(), next.end());
+        next.clear();
+    }
+}
+
+void ParallelPushRelabel::LockNeighbour(size_t vertex, size_t to) {
+    // Two neighbours discharged at once can keep failing each other's try-lock, so after a few
+    // attempts the pair is locked in vertex id order, which cannot deadlock.
+    for (size_t attempt = 0; attempt < kLockAttempts; attempt++) {
+        if (TryLock(to)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+    if (vertex > to) {
+        Unlock(vertex);
+        Lock(to);
+    }
+    Lock(std::max(vertex, to));
+}
+
+void ParallelPushRelabel::Lock(size_t vertex) {
+    while (!TryLock(vertex)) {
+        std::this_thread::yield();
+    }
+}
+
+bool ParallelPushRelabel::TryLock(size_t vertex) {
+    return !locks_[vertex].exchange(true, std::memory_order_acquire);
+}
+
+void ParallelPushRelabel::Unlock(size_t vertex) {
+    locks_[vertex].store(false, std::memory_order_release);
+}
+}  // namespace max_flow_app
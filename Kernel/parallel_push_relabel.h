@@ -0,0 +1,51 @@
+#ifndef PARALLEL_PUSH_RELABEL_H
+#define PARALLEL_PUSH_RELABEL_H
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <thread>
+#include "Library/thread_pool.h"
+#include "residual_network.h"
+
+namespace max_flow_app {
+class ParallelPushRelabel {
+public:
+    explicit ParallelPushRelabel(size_t threads_number = std::thread::hardware_concurrency());
+
+    size_t Run(ResidualNetwork& network, size_t source, size_t sink);
+    size_t GetThreadsNumber() const;
+
+private:
+    void Init(ResidualNetwork& network, size_t source);
+    void RunPhase(ResidualNetwork& network, size_t target, size_t blocked);
+    void GlobalRelabel(const ResidualNetwork& network, size_t target, size_t blocked);
+    void Discharge(ResidualNetwork& network, size_t vertex, size_t target, size_t blocked,
+                   std::vector<size_t>& next);
+    void Relabel(const ResidualNetwork& network, size_t vertex);
+    void ApplyGap();
+    void Enqueue(size_t vertex, std::vector<size_t>& next);
+    void MergeNextActive();
+    void LockNeighbour(size_t vertex, size_t to);
+    void Lock(size_t vertex);
+    bool TryLock(size_t vertex);
+    void Unlock(size_t vertex);
+
+    static constexpr size_t kGlobalRelabelFrequency = 6;
+    static constexpr size_t kGrain = 64;
+    static constexpr size_t kLockAttempts = 4;
+    thread_pool::ThreadPool pool_;
+    size_t n_ = 0;
+    std::vector<std::atomic<size_t>> heights_;
+    std::vector<std::atomic<size_t>> height_counts_;
+    std::vector<std::atomic<bool>> locks_;
+    std::vector<std::atomic<bool>> is_queued_;
+    std::vector<size_t> excess_;
+    std::vector<size_t> current_arcs_;
+    std::vector<size_t> active_;
+    std::vector<std::vector<size_t>> next_active_;
+    std::atomic<size_t> work_since_relabel_ = 0;
+    std::atomic<size_t> gap_height_ = 0;
+    size_t work_since_gap_mark_ = 0;
+};
+}  // namespace max_flow_app
+#endif  // PARALLEL_PUSH_RELABEL_H
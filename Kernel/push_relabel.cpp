@@ -0,0 +1,179 @@
+#include "push_relabel.h"
+#include <algorithm>
+#include <cassert>
+
+namespace max_flow_app {
+size_t PushRelabel::Run(ResidualNetwork& network, size_t source, size_t sink) {
+    assert(source != sink);
+    Init(network, source);
+    RunPhase(network, sink, source);
+    size_t flow = excess_[sink];
+    RunPhase(network, source, sink);
+    return flow;
+}
+
+void PushRelabel::Init(ResidualNetwork& network, size_t source) {
+    n_ = network.GetVerticesNumber();
+    heights_.assign(n_, 0);
+    excess_.assign(n_, 0);
+    current_arcs_.resize(n_);
+    bucket_heads_.resize(n_ + 1);
+    next_in_bucket_.resize(n_);
+    prev_in_bucket_.resize(n_);
+    active_.resize(n_ + 1);
+    for (size_t i = network.Begin(source); i < network.End(source); i++) {
+        size_t residual = network.GetResidual(i);
+        excess_[network.GetHead(i)] += residual;
+        network.Push(i, residual);
+    }
+}
+
+void PushRelabel::RunPhase(ResidualNetwork& network, size_t target, size_t blocked) {
+    GlobalRelabel(network, target, blocked);
+    while (true) {
+        while (max_active_height_ > 0 && active_[max_active_height_].empty()) {
+            max_active_height_--;
+        }
+        if (!max_active_height_) {
+            return;
+        }
+        size_t vertex = active_[max_active_height_].back();
+        active_[max_active_height_].pop_back();
+        if (heights_[vertex] != max_active_height_ || !excess_[vertex]) {
+            continue;
+        }
+        Discharge(network, vertex, target, blocked);
+        if (work_since_relabel_ > kGlobalRelabelFrequency * n_ + network.GetArcsNumber()) {
+            GlobalRelabel(network, target, blocked);
+        }
+    }
+}
+
+void PushRelabel::GlobalRelabel(const ResidualNetwork& network, size_t target, size_t blocked) {
+    heights_.assign(n_, n_);
+    heights_[target] = 0;
+    queue_.assign(1, target);
+    for (size_t head = 0; head < queue_.size(); head++) {
+        size_t vertex = queue_[head];
+        for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+            size_t to = network.GetHead(i);
+            if (heights_[to] != n_ || to == blocked ||
+                !network.GetResidual(network.GetReverse(i))) {
+                continue;
+            }
+            heights_[to] = heights_[vertex] + 1;
+            queue_.push_back(to);
+        }
+    }
+    bucket_heads_.assign(n_ + 1, kNone);
+    max_height_ = 0;
+    for (auto& bucket : active_) {
+        bucket.clear();
+    }
+    max_active_height_ = 0;
+    work_since_relabel_ = 0;
+    for (size_t vertex = 0; vertex < n_; vertex++) {
+        Link(vertex);
+        current_arcs_[vertex] = network.Begin(vertex);
+        if (excess_[vertex] && vertex != target && vertex != blocked && heights_[vertex] < n_) {
+            Activate(vertex);
+        }
+    }
+}
+
+void PushRelabel::Discharge(ResidualNetwork& network, size_t vertex, size_t target,
+                            size_t blocked) {
+    while (excess_[vertex]) {
+        if (current_arcs_[vertex] == network.End(vertex)) {
+            Relabel(network, vertex);
+            if (heights_[vertex] >= n_) {
+                return;
+            }
+            continue;
+        }
+        size_t index = current_arcs_[vertex];
+        size_t to = network.GetHead(index);
+        size_t residual = network.GetResidual(index);
+        if (!residual || heights_[vertex] != heights_[to] + 1) {
+            current_arcs_[vertex]++;
+            continue;
+        }
+        size_t flow = std::min(excess_[vertex], residual);
+        network.Push(index, flow);
+        excess_[vertex] -= flow;
+        if (!excess_[to] && to != target && to != blocked) {
+            Activate(to);
+        }
+        excess_[to] += flow;
+    }
+}
+
+void PushRelabel::Relabel(const ResidualNetwork& network, size_t vertex) {
+    size_t old_height = heights_[vertex];
+    size_t new_height = n_;
+    for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+        if (network.GetResidual(i)) {
+            new_height = std::min(new_height, heights_[network.GetHead(i)] + 1);
+        }
+    }
+    work_since_relabel_ += network.End(vertex) - network.Begin(vertex) + kGlobalRelabelFrequency;
+    SetHeight(vertex, new_height);
+    current_arcs_[vertex] = network.Begin(vertex);
+    if (bucket_heads_[old_height] == kNone) {
+        Gap(old_height);
+    }
+}
+
+void PushRelabel::Gap(size_t height) {
+    for (size_t cur = height + 1; cur <= max_height_; cur++) {
+        for (size_t vertex = bucket_heads_[cur]; vertex != kNone;
+             vertex = next_in_bucket_[vertex]) {
+            heights_[vertex] = n_;
+        }
+        bucket_heads_[cur] = kNone;
+    }
+    max_height_ = std::min(max_height_, height);
+}
+
+void PushRelabel::Activate(size_t vertex) {
+    if (heights_[vertex] >= n_) {
+        return;
+    }
+    active_[heights_[vertex]].push_back(vertex);
+    max_active_height_ = std::max(max_active_height_, heights_[vertex]);
+}
+
+void PushRelabel::SetHeight(size_t vertex, size_t height) {
+    Unlink(vertex);
+    heights_[vertex] = std::min(height, n_);
+    Link(vertex);
+}
+
+void PushRelabel::Link(size_t vertex) {
+    size_t height = heights_[vertex];
+    if (height >= n_) {
+        return;
+    }
+    prev_in_bucket_[vertex] = kNone;
+    next_in_bucket_[vertex] = bucket_heads_[height];
+    if (bucket_heads_[height] != kNone) {
+        prev_in_bucket_[bucket_heads_[height]] = vertex;
+    }
+    bucket_heads_[height] = vertex;
+    max_height_ = std::max(max_height_, height);
+}
+
+void PushRelabel::Unlink(size_t vertex) {
+    if (heights_[vertex] >= n_) {
+        return;
+    }
+    if (prev_in_bucket_[vertex] == kNone) {
+        bucket_heads_[heights_[vertex]] = next_in_bucket_[vertex];
+    } else {
+        next_in_bucket_[prev_in_bucket_[vertex]] = next_in_bucket_[vertex];
+    }
+    if (next_in_bucket_[vertex] != kNone) {
+        prev_in_bucket_[next_in_bucket_[vertex]] = prev_in_bucket_[vertex];
+    }
+}
+}  // namespace max_flow_app
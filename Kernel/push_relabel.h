@@ -0,0 +1,41 @@
+#ifndef PUSH_RELABEL_H
+#define PUSH_RELABEL_H
+#include <vector>
+#include <cstddef>
+#include <string>
+#include "residual_network.h"
+
+namespace max_flow_app {
+class PushRelabel {
+public:
+    size_t Run(ResidualNetwork& network, size_t source, size_t sink);
+
+private:
+    void Init(ResidualNetwork& network, size_t source);
+    void RunPhase(ResidualNetwork& network, size_t target, size_t blocked);
+    void GlobalRelabel(const ResidualNetwork& network, size_t target, size_t blocked);
+    void Discharge(ResidualNetwork& network, size_t vertex, size_t target, size_t blocked);
+    void Relabel(const ResidualNetwork& network, size_t vertex);
+    void Gap(size_t height);
+    void Activate(size_t vertex);
+    void SetHeight(size_t vertex, size_t height);
+    void Link(size_t vertex);
+    void Unlink(size_t vertex);
+
+    static constexpr size_t kGlobalRelabelFrequency = 6;
+    static constexpr size_t kNone = std::string::npos;
+    size_t n_ = 0;
+    size_t max_active_height_ = 0;
+    size_t max_height_ = 0;
+    size_t work_since_relabel_ = 0;
+    std::vector<size_t> heights_;
+    std::vector<size_t> excess_;
+    std::vector<size_t> current_arcs_;
+    std::vector<size_t> bucket_heads_;
+    std::vector<size_t> next_in_bucket_;
+    std::vector<size_t> prev_in_bucket_;
+    std::vector<std::vector<size_t>> active_;
+    std::vector<size_t> queue_;
+};
+}  // namespace max_flow_app
+#endif  // PUSH_RELABEL_H
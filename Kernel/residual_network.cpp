@@ -0,0 +1,79 @@
+#include "residual_network.h"
+#include <cassert>
+#include <stdexcept>
+
+namespace max_flow_app {
+template <class Capacity>
+BasicResidualNetwork<Capacity>::BasicResidualNetwork(size_t n, const std::vector<Edge>& edges) {
+    Build(n, edges);
+}
+
+template <class Capacity>
+bool BasicResidualNetwork<Capacity>::IsIndexable(size_t n, size_t edges_number) {
+    return n <= kMaxArcsNumber && edges_number <= (kMaxArcsNumber >> 1);
+}
+
+template <class Capacity>
+void BasicResidualNetwork<Capacity>::Build(size_t n, const std::vector<Edge>& edges) {
+    if (!IsIndexable(n, edges.size())) {
+        throw std::length_error("Residual network exceeds 32-bit arc indices");
+    }
+    n_ = n;
+    offsets_.assign(n_ + 1, 0);
+    for (const auto& edge : edges) {
+        assert(edge.u < n_ && edge.to < n_);
+        offsets_[edge.u + 1]++;
+        offsets_[edge.to + 1]++;
+    }
+    for (size_t i = 0; i < n_; i++) {
+        offsets_[i + 1] += offsets_[i];
+    }
+    std::vector<Index> positions(offsets_.begin(), offsets_.end() - 1);
+    heads_.resize(edges.size() << 1);
+    residuals_.resize(edges.size() << 1);
+    reverses_.resize(edges.size() << 1);
+    edge_arcs_.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        auto [u, to, delta] = edges[i];
+        Index forward = positions[u]++;
+        Index backward = positions[to]++;
+        heads_[forward] = static_cast<Index>(to);
+        residuals_[forward] = delta;
+        reverses_[forward] = backward;
+        heads_[backward] = static_cast<Index>(u);
+        residuals_[backward] = Capacity{0};
+        reverses_[backward] = forward;
+        edge_arcs_[i] = forward;
+    }
+}
+
+template <class Capacity>
+size_t BasicResidualNetwork<Capacity>::GetVerticesNumber() const {
+    return n_;
+}
+
+template <class Capacity>
+size_t BasicResidualNetwork<Capacity>::GetArcsNumber() const {
+    return heads_.size();
+}
+
+template <class Capacity>
+size_t BasicResidualNetwork<Capacity>::GetEdgesNumber() const {
+    return edge_arcs_.size();
+}
+
+template <class Capacity>
+size_t BasicResidualNetwork<Capacity>::GetEdgeArc(size_t edge_id) const {
+    return edge_arcs_[edge_id];
+}
+
+template <class Capacity>
+Capacity BasicResidualNetwork<Capacity>::GetFlow(size_t edge_id) const {
+    return residuals_[reverses_[edge_arcs_[edge_id]]];
+}
+
+template class BasicResidualNetwork<size_t>;
+template class BasicResidualNetwork<int32_t>;
+template class BasicResidualNetwork<int64_t>;
+template class BasicResidualNetwork<double>;
+}  // namespace max_flow_app
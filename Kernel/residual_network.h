@@ -0,0 +1,75 @@
+#ifndef RESIDUAL_NETWORK_H
+#define RESIDUAL_NETWORK_H
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "kernel_messages.h"
+
+namespace max_flow_app {
+template <class Capacity>
+class BasicResidualNetwork {
+public:
+    using Edge = kernel_messages::CapacityEdge<Capacity>;
+    using Index = uint32_t;
+
+    static constexpr size_t kMaxArcsNumber = std::numeric_limits<Index>::max();
+
+    BasicResidualNetwork() = default;
+    BasicResidualNetwork(size_t n, const std::vector<Edge>& edges);
+
+    static bool IsIndexable(size_t n, size_t edges_number);
+    // Throws std::length_error when the network does not fit the 32-bit arc indices.
+    void Build(size_t n, const std::vector<Edge>& edges);
+    size_t GetVerticesNumber() const;
+    size_t GetArcsNumber() const;
+    size_t GetEdgesNumber() const;
+    size_t GetEdgeArc(size_t edge_id) const;
+    Capacity GetFlow(size_t edge_id) const;
+
+    size_t Begin(size_t vertex) const {
+        return offsets_[vertex];
+    }
+
+    size_t End(size_t vertex) const {
+        return offsets_[vertex + 1];
+    }
+
+    size_t GetHead(size_t index) const {
+        return heads_[index];
+    }
+
+    size_t GetReverse(size_t index) const {
+        return reverses_[index];
+    }
+
+    Capacity& GetResidual(size_t index) {
+        return residuals_[index];
+    }
+
+    const Capacity& GetResidual(size_t index) const {
+        return residuals_[index];
+    }
+
+    void Push(size_t index, Capacity flow) {
+        residuals_[index] -= flow;
+        residuals_[reverses_[index]] += flow;
+    }
+
+private:
+    size_t n_ = 0;
+    std::vector<Index> offsets_ = std::vector<Index>(1);
+    std::vector<Index> heads_;
+    std::vector<Capacity> residuals_;
+    std::vector<Index> reverses_;
+    std::vector<Index> edge_arcs_;
+};
+
+using ResidualNetwork = BasicResidualNetwork<size_t>;
+
+extern template class BasicResidualNetwork<size_t>;
+extern template class BasicResidualNetwork<int32_t>;
+extern template class BasicResidualNetwork<int64_t>;
+extern template class BasicResidualNetwork<double>;
+}  // namespace max_flow_app
+#endif  // RESIDUAL_NETWORK_H
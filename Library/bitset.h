@@ -0,0 +1,62 @@
+#ifndef BITSET_H
+#define BITSET_H
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bitset {
+class DynamicBitset {
+public:
+    using Word = uint64_t;
+    static constexpr size_t kWordBits = 64;
+
+    DynamicBitset() = default;
+    explicit DynamicBitset(size_t size) : size_(size), words_(GetWordsNumber(size)) {
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    void Assign(size_t size) {
+        size_ = size;
+        words_.assign(GetWordsNumber(size), 0);
+    }
+
+    bool Test(size_t index) const {
+        assert(index < size_);
+        return (words_[index / kWordBits] >> (index % kWordBits)) & 1;
+    }
+
+    void Set(size_t index) {
+        assert(index < size_);
+        words_[index / kWordBits] |= Word{1} << (index % kWordBits);
+    }
+
+    void Reset(size_t index) {
+        assert(index < size_);
+        words_[index / kWordBits] &= ~(Word{1} << (index % kWordBits));
+    }
+
+    size_t Count() const {
+        size_t count = 0;
+        for (Word word : words_) {
+            count += std::popcount(word);
+        }
+        return count;
+    }
+
+    bool operator==(const DynamicBitset& other) const = default;
+
+private:
+    static size_t GetWordsNumber(size_t size) {
+        return (size + kWordBits - 1) / kWordBits;
+    }
+
+    size_t size_ = 0;
+    std::vector<Word> words_;
+};
+}  // namespace bitset
+#endif  // BITSET_H
@@ -0,0 +1,96 @@
+#ifndef CHANNEL_H
+#define CHANNEL_H
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+namespace channel {
+template <class T>
+class Channel {
+public:
+    explicit Channel(size_t capacity = std::numeric_limits<size_t>::max())
+        : capacity_(std::max<size_t>(capacity, 1)) {
+    }
+
+    Channel(const Channel&) = delete;
+    Channel(Channel&&) = delete;
+    Channel& operator=(const Channel&) = delete;
+    Channel& operator=(Channel&&) = delete;
+
+    // Waits while the channel is full. Returns false and drops the value when the channel is
+    // closed or the stop token is stopped before a slot frees up.
+    bool Push(T value, std::stop_token stop_token = {}) {
+        {
+            std::unique_lock lock(mutex_);
+            bool has_slot = not_full_.wait(lock, stop_token, [this]() {
+                return is_closed_ || queue_.size() < capacity_;
+            });
+            if (!has_slot || is_closed_) {
+                return false;
+            }
+            queue_.push_back(std::move(value));
+        }
+        ready_.notify_one();
+        return true;
+    }
+
+    std::optional<T> Pop() {
+        std::unique_lock lock(mutex_);
+        ready_.wait(lock, [this]() { return is_closed_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(queue_.front()));
+        queue_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return value;
+    }
+
+    std::optional<T> TryPop() {
+        std::unique_lock lock(mutex_);
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(queue_.front()));
+        queue_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return value;
+    }
+
+    std::deque<T> TryPopAll() {
+        std::deque<T> values;
+        {
+            std::lock_guard lock(mutex_);
+            values.swap(queue_);
+        }
+        not_full_.notify_all();
+        return values;
+    }
+
+    void Close() {
+        {
+            std::lock_guard lock(mutex_);
+            is_closed_ = true;
+        }
+        ready_.notify_all();
+        not_full_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable_any not_full_;
+    std::deque<T> queue_;
+    size_t capacity_;
+    bool is_closed_ = false;
+};
+}  // namespace channel
+#endif  // CHANNEL_H
@@ -103,7 +103,7 @@ public:
     }
 
     void Notify() {
-        if (!data_producer_) {
+        if (!data_producer_ || subscribers_.empty()) {
             return;
         }
         const DataType& data = data_producer_();
@@ -122,6 +122,10 @@ public:
         return data_producer_();
     }
 
+    bool HasSubscribers() const {
+        return !subscribers_.empty();
+    }
+
 private:
     friend class Observer<DataType>;
 
@@ -0,0 +1,150 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace thread_pool {
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads_number = std::thread::hardware_concurrency())
+        : ranges_(std::max<size_t>(threads_number, 1)) {
+        for (size_t i = 1; i < ranges_.size(); i++) {
+            workers_.emplace_back([this, i]() { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            is_stopped_ = true;
+        }
+        job_started_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    size_t GetThreadsNumber() const {
+        return ranges_.size();
+    }
+
+    template <class Func>
+    void ParallelFor(size_t count, Func&& func, size_t grain = 1) {
+        if (!count) {
+            return;
+        }
+        grain = std::max<size_t>(grain, 1);
+        size_t chunk = (count + ranges_.size() - 1) / ranges_.size();
+        for (size_t i = 0; i < ranges_.size(); i++) {
+            ranges_[i].begin = std::min(count, i * chunk);
+            ranges_[i].end = std::min(count, (i + 1) * chunk);
+        }
+        std::function<void(size_t, size_t)> job = [&func](size_t index, size_t thread_id) {
+            func(index, thread_id);
+        };
+        {
+            std::lock_guard lock(mutex_);
+            job_ = &job;
+            grain_ = grain;
+            active_workers_ = workers_.size();
+            job_id_++;
+        }
+        job_started_.notify_all();
+        RunJob(0);
+        std::unique_lock lock(mutex_);
+        job_finished_.wait(lock, [this]() { return !active_workers_; });
+        job_ = nullptr;
+    }
+
+private:
+    struct Range {
+        std::mutex mutex;
+        size_t begin = 0, end = 0;
+    };
+
+    void WorkerLoop(size_t thread_id) {
+        size_t last_job_id = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex_);
+                job_started_.wait(
+                    lock, [this, last_job_id]() { return is_stopped_ || job_id_ != last_job_id; });
+                if (is_stopped_) {
+                    return;
+                }
+                last_job_id = job_id_;
+            }
+            RunJob(thread_id);
+            std::lock_guard lock(mutex_);
+            if (!--active_workers_) {
+                job_finished_.notify_one();
+            }
+        }
+    }
+
+    void RunJob(size_t thread_id) {
+        size_t begin, end;
+        while (TakeOwn(thread_id, begin, end) || Steal(thread_id, begin, end)) {
+            for (size_t i = begin; i < end; i++) {
+                (*job_)(i, thread_id);
+            }
+        }
+    }
+
+    bool TakeOwn(size_t thread_id, size_t& begin, size_t& end) {
+        Range& range = ranges_[thread_id];
+        std::lock_guard lock(range.mutex);
+        if (range.begin == range.end) {
+            return false;
+        }
+        begin = range.begin;
+        end = std::min(range.end, begin + grain_);
+        range.begin = end;
+        return true;
+    }
+
+    bool Steal(size_t thread_id, size_t& begin, size_t& end) {
+        for (size_t shift = 1; shift < ranges_.size(); shift++) {
+            Range& victim = ranges_[(thread_id + shift) % ranges_.size()];
+            std::unique_lock lock(victim.mutex);
+            if (victim.begin == victim.end) {
+                continue;
+            }
+            size_t middle = victim.begin + (victim.end - victim.begin) / 2;
+            begin = middle;
+            end = victim.end;
+            victim.end = middle;
+            lock.unlock();
+            Range& own = ranges_[thread_id];
+            std::lock_guard own_lock(own.mutex);
+            own.begin = std::min(end, begin + grain_);
+            own.end = end;
+            end = own.begin;
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<Range> ranges_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable job_started_;
+    std::condition_variable job_finished_;
+    std::function<void(size_t, size_t)>* job_ = nullptr;
+    size_t grain_ = 1;
+    size_t job_id_ = 0;
+    size_t active_workers_ = 0;
+    bool is_stopped_ = false;
+};
+}  // namespace thread_pool
+#endif  // THREAD_POOL_H
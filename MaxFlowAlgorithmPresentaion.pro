@@ -17,6 +17,17 @@ LIBS += $$CONAN_LIBDIRS_QWT $$CONAN_LIBS_QWT
 
 SOURCES += \
     Kernel/max_flow.cpp \
+    Kernel/residual_network.cpp \
+    Kernel/push_relabel.cpp \
+    Kernel/parallel_push_relabel.cpp \
+    Kernel/boykov_kolmogorov.cpp \
+    Kernel/min_cost_flow.cpp \
+    Kernel/dinic.cpp \
+    Kernel/link_cut_tree.cpp \
+    Kernel/batch_solver.cpp \
+    Kernel/gomory_hu.cpp \
+    Kernel/hopcroft_karp.cpp \
+    Kernel/network_reduction.cpp \
     Kernel/kernel_messages.cpp \
     Kernel/controller.cpp \
     Interface/geom_model.cpp \
@@ -29,6 +40,17 @@ SOURCES += \
 
 HEADERS += \
     Kernel/max_flow.h \
+    Kernel/residual_network.h \
+    Kernel/push_relabel.h \
+    Kernel/parallel_push_relabel.h \
+    Kernel/boykov_kolmogorov.h \
+    Kernel/min_cost_flow.h \
+    Kernel/dinic.h \
+    Kernel/link_cut_tree.h \
+    Kernel/batch_solver.h \
+    Kernel/gomory_hu.h \
+    Kernel/hopcroft_karp.h \
+    Kernel/network_reduction.h \
     Kernel/controller.h \
     Kernel/kernel_messages.h \
     Interface/geom_model.h \
@@ -38,6 +60,9 @@ HEADERS += \
     Interface/drawer_helper.h \
     application.h \
     Library/observer_pattern.h \
+    Library/thread_pool.h \
+    Library/channel.h \
+    Library/bitset.h \
     Interface/interface_messages.h \
 
 FORMS += \
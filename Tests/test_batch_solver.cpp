@@ -0,0 +1,91 @@
+#include "catch.hpp"
+#include "../Kernel/batch_solver.h"
+#include "../Kernel/max_flow.h"
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+using namespace observer_pattern;
+
+namespace {
+FlowInstance GenRandomInstance(std::mt19937& gen) {
+    FlowInstance instance{.n = gen() % 9 + 2, .edges = {}};
+    for (size_t i = 0; i < 3 * instance.n; i++) {
+        size_t u = gen() % instance.n, to = gen() % instance.n;
+        if (u != to) {
+            instance.edges.push_back({u, to, gen() % 100 + 1});
+        }
+    }
+    return instance;
+}
+
+size_t SolveMaxFlow(const FlowInstance& instance) {
+    MaxFlow max_flow(instance.n, instance.edges);
+    max_flow.RunRequest(Engine::PushRelabel);
+    return max_flow.GetMinCut().capacity;
+}
+}  // namespace
+
+TEST_CASE("Batch solver matches MaxFlow") {
+    std::mt19937 gen(31);
+    std::vector<FlowInstance> instances;
+    for (size_t i = 0; i < 1000; i++) {
+        instances.push_back(GenRandomInstance(gen));
+    }
+    BatchSolver solver(4);
+    auto results = solver.Solve(instances);
+    REQUIRE(results.size() == instances.size());
+    for (size_t i = 0; i < instances.size(); i++) {
+        REQUIRE(results[i].flow == SolveMaxFlow(instances[i]));
+        REQUIRE(results[i].edge_flows.empty());
+    }
+}
+
+TEST_CASE("Batch solver edge flows") {
+    std::mt19937 gen(37);
+    std::vector<FlowInstance> instances;
+    for (size_t i = 0; i < 500; i++) {
+        instances.push_back(GenRandomInstance(gen));
+        instances.back().source = gen() % instances.back().n;
+        instances.back().sink = (instances.back().source + 1) % instances.back().n;
+    }
+    BatchSolver solver(3);
+    auto results = solver.Solve(instances, true);
+    for (size_t i = 0; i < instances.size(); i++) {
+        const auto& instance = instances[i];
+        REQUIRE(results[i].edge_flows.size() == instance.edges.size());
+        std::vector<int64_t> balance(instance.n);
+        for (size_t j = 0; j < instance.edges.size(); j++) {
+            size_t flow = results[i].edge_flows[j];
+            REQUIRE(flow <= instance.edges[j].delta);
+            balance[instance.edges[j].u] -= flow;
+            balance[instance.edges[j].to] += flow;
+        }
+        for (size_t vertex = 0; vertex < instance.n; vertex++) {
+            int64_t expected = 0;
+            if (vertex == instance.source) {
+                expected = -static_cast<int64_t>(results[i].flow);
+            } else if (vertex == instance.sink) {
+                expected = results[i].flow;
+            }
+            REQUIRE(balance[vertex] == expected);
+        }
+    }
+}
+
+TEST_CASE("Batch solver degenerate instances") {
+    std::vector<FlowInstance> instances = {
+        {.n = 1, .edges = {}},
+        {.n = 3, .edges = {{0, 1, 5}, {1, 2, 5}}, .source = 1, .sink = 1},
+        {.n = 2, .edges = {{0, 1, 7}}},
+        {.n = 0, .edges = {}}};
+    BatchSolver solver(2);
+    auto results = solver.Solve(instances, true);
+    REQUIRE(results[0].flow == 0);
+    REQUIRE(results[0].edge_flows.empty());
+    REQUIRE(results[1].flow == 0);
+    REQUIRE(results[1].edge_flows == std::vector<size_t>{0, 0});
+    REQUIRE(results[2].flow == 7);
+    REQUIRE(results[2].edge_flows == std::vector<size_t>{7});
+    REQUIRE(results[3].flow == 0);
+}
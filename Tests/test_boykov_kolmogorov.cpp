@@ -0,0 +1,101 @@
+#include "catch.hpp"
+#include "../Kernel/boykov_kolmogorov.h"
+#include "../Kernel/push_relabel.h"
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+std::vector<BasicEdge> GenGrid(std::mt19937& gen, size_t width, size_t height, bool is_diagonal) {
+    std::vector<BasicEdge> edges;
+    size_t n = width * height + 2;
+    for (size_t i = 0; i < width * height; i++) {
+        edges.push_back({0, i + 1, gen() % 20});
+        edges.push_back({i + 1, n - 1, gen() % 20});
+    }
+    for (size_t x = 0; x < width; x++) {
+        for (size_t y = 0; y < height; y++) {
+            size_t vertex = y * width + x + 1;
+            if (x + 1 < width) {
+                edges.push_back({vertex, vertex + 1, gen() % 10});
+                edges.push_back({vertex + 1, vertex, gen() % 10});
+            }
+            if (y + 1 < height) {
+                edges.push_back({vertex, vertex + width, gen() % 10});
+                edges.push_back({vertex + width, vertex, gen() % 10});
+            }
+            if (is_diagonal && x + 1 < width && y + 1 < height) {
+                edges.push_back({vertex, vertex + width + 1, gen() % 5});
+                edges.push_back({vertex + width + 1, vertex, gen() % 5});
+            }
+        }
+    }
+    return edges;
+}
+
+void CheckFlow(const ResidualNetwork& network, const std::vector<BasicEdge>& edges, size_t n,
+               size_t source, size_t sink, size_t flow) {
+    std::vector<ssize_t> balance(n);
+    for (size_t i = 0; i < edges.size(); i++) {
+        size_t edge_flow = network.GetFlow(i);
+        REQUIRE(edge_flow <= edges[i].delta);
+        balance[edges[i].u] -= edge_flow;
+        balance[edges[i].to] += edge_flow;
+    }
+    for (size_t vertex = 0; vertex < n; vertex++) {
+        if (vertex != source && vertex != sink) {
+            REQUIRE(balance[vertex] == 0);
+        }
+    }
+    REQUIRE(balance[sink] == static_cast<ssize_t>(flow));
+}
+}  // namespace
+
+TEST_CASE("Boykov-Kolmogorov basic") {
+    std::vector<BasicEdge> edges = {{0, 1, 1}, {0, 2, 2}, {2, 1, 1}, {1, 3, 2}, {2, 3, 1}};
+    ResidualNetwork network(4, edges);
+    BoykovKolmogorov boykov_kolmogorov;
+    REQUIRE(boykov_kolmogorov.Run(network, 0, 3) == 3);
+    CheckFlow(network, edges, 4, 0, 3, 3);
+}
+
+TEST_CASE("Boykov-Kolmogorov on grids") {
+    std::mt19937 gen(5);
+    BoykovKolmogorov boykov_kolmogorov;
+    PushRelabel push_relabel;
+    for (size_t test = 0; test < 40; test++) {
+        size_t width = gen() % 20 + 1, height = gen() % 20 + 1;
+        size_t n = width * height + 2;
+        auto edges = GenGrid(gen, width, height, test & 1);
+        ResidualNetwork expected_network(n, edges);
+        size_t expected = push_relabel.Run(expected_network, 0, n - 1);
+        ResidualNetwork network(n, edges);
+        size_t flow = boykov_kolmogorov.Run(network, 0, n - 1);
+        REQUIRE(flow == expected);
+        CheckFlow(network, edges, n, 0, n - 1, flow);
+    }
+}
+
+TEST_CASE("Boykov-Kolmogorov on random graphs") {
+    std::mt19937 gen(13);
+    BoykovKolmogorov boykov_kolmogorov;
+    PushRelabel push_relabel;
+    for (size_t test = 0; test < 200; test++) {
+        size_t n = gen() % 40 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t i = gen() % (5 * n); i != 0; i--) {
+            size_t u = gen() % n, to = gen() % n;
+            if (u != to) {
+                edges.push_back({u, to, gen() % 30 + 1});
+            }
+        }
+        size_t source = gen() % n, sink = (source + 1 + gen() % (n - 1)) % n;
+        ResidualNetwork expected_network(n, edges);
+        size_t expected = push_relabel.Run(expected_network, source, sink);
+        ResidualNetwork network(n, edges);
+        size_t flow = boykov_kolmogorov.Run(network, source, sink);
+        REQUIRE(flow == expected);
+        CheckFlow(network, edges, n, source, sink, flow);
+    }
+}
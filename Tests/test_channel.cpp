@@ -0,0 +1,186 @@
+#include "catch.hpp"
+#include "../Library/channel.h"
+#include "../Kernel/max_flow.h"
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+using namespace channel;
+using namespace max_flow_app;
+using namespace kernel_messages;
+using namespace observer_pattern;
+
+namespace {
+struct Frame {
+    MaxFlowData data;
+    bool is_unlock = false;
+    bool operator==(const Frame& other) const = default;
+};
+
+class FrameRecorder {
+public:
+    explicit FrameRecorder(Channel<Frame>* frames)
+        : network_observer_([frames](const MaxFlowData& data) { frames->Push({.data = data}); }),
+          flow_observer_([](const MaxFlowData&) {},
+                         [frames](const MaxFlowData& data) { frames->Push({.data = data}); },
+                         [](const MaxFlowData&) {}),
+          unlock_observer_([]() {},
+                           [frames]() { frames->Push({.data = {}, .is_unlock = true}); },
+                           []() {}) {
+    }
+
+    void Register(MaxFlow& max_flow) {
+        max_flow.RegisterNetworkObserver(&network_observer_);
+        max_flow.RegisterFlowObserver(&flow_observer_);
+        max_flow.RegisterUnlockObserver(&unlock_observer_);
+    }
+
+private:
+    Observer<MaxFlowData> network_observer_;
+    Observer<MaxFlowData> flow_observer_;
+    Observer<void> unlock_observer_;
+};
+}  // namespace
+
+TEST_CASE("Channel keeps order") {
+    Channel<size_t> channel;
+    const size_t count = 100000;
+    std::jthread producer([&channel]() {
+        for (size_t i = 0; i < count; i++) {
+            channel.Push(i);
+        }
+        channel.Close();
+    });
+    size_t expected = 0;
+    while (auto value = channel.Pop()) {
+        REQUIRE(*value == expected++);
+    }
+    REQUIRE(expected == count);
+}
+
+TEST_CASE("Channel with multiple producers") {
+    Channel<std::pair<size_t, size_t>> channel;
+    const size_t producers_number = 4, count = 20000;
+    std::vector<std::jthread> producers;
+    for (size_t id = 0; id < producers_number; id++) {
+        producers.emplace_back([&channel, id]() {
+            for (size_t i = 0; i < count; i++) {
+                channel.Push({id, i});
+            }
+        });
+    }
+    std::vector<size_t> next(producers_number);
+    size_t received = 0;
+    while (received < producers_number * count) {
+        for (auto [id, value] : channel.TryPopAll()) {
+            REQUIRE(value == next[id]++);
+            received++;
+        }
+    }
+    REQUIRE(channel.TryPopAll().empty());
+}
+
+TEST_CASE("Channel close") {
+    Channel<int> channel;
+    std::optional<int> popped = 0;
+    std::jthread consumer([&channel, &popped]() { popped = channel.Pop(); });
+    channel.Close();
+    consumer.join();
+    REQUIRE(!popped);
+    REQUIRE(!channel.Push(1));
+    REQUIRE(channel.TryPopAll().empty());
+
+    Channel<int> pending;
+    pending.Push(1);
+    pending.Push(2);
+    pending.Close();
+    REQUIRE(pending.Pop() == 1);
+    REQUIRE(pending.Pop() == 2);
+    REQUIRE(!pending.Pop());
+}
+
+TEST_CASE("Bounded channel") {
+    const size_t capacity = 4, count = 10000;
+    Channel<size_t> channel(capacity);
+    std::atomic<size_t> pushed = 0;
+    std::jthread producer([&channel, &pushed]() {
+        for (size_t i = 0; i < count; i++) {
+            channel.Push(i);
+            pushed++;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    REQUIRE(pushed <= capacity);
+    for (size_t i = 0; i < count; i++) {
+        REQUIRE(pushed <= i + capacity);
+        auto value = i % 2 ? channel.Pop() : channel.TryPop();
+        while (!value) {
+            value = channel.TryPop();
+        }
+        REQUIRE(*value == i);
+    }
+    producer.join();
+    REQUIRE(!channel.TryPop());
+
+    Channel<int> full(1);
+    full.Push(1);
+    bool is_pushed = true;
+    std::jthread blocked([&full, &is_pushed]() { is_pushed = full.Push(2); });
+    full.Close();
+    blocked.join();
+    REQUIRE(!is_pushed);
+
+    Channel<int> stopped(1);
+    stopped.Push(1);
+    std::stop_source stop_source;
+    bool is_stopped_pushed = true;
+    std::jthread stopped_producer([&stopped, &is_stopped_pushed, &stop_source]() {
+        is_stopped_pushed = stopped.Push(2, stop_source.get_token());
+    });
+    stop_source.request_stop();
+    stopped_producer.join();
+    REQUIRE(!is_stopped_pushed);
+    REQUIRE(stopped.TryPop() == 1);
+    REQUIRE(!stopped.TryPop());
+}
+
+TEST_CASE("Solver frames through a channel") {
+    std::mt19937 gen(37);
+    for (size_t test = 0; test < 30; test++) {
+        size_t n = gen() % 8 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 3 * n; i++) {
+            size_t u = gen() % n, to = gen() % n;
+            if (u != to) {
+                edges.push_back({u, to, gen() % 100 + 1});
+            }
+        }
+
+        Channel<Frame> expected_frames;
+        FrameRecorder expected_recorder(&expected_frames);
+        MaxFlow expected_max_flow(n, edges);
+        expected_recorder.Register(expected_max_flow);
+        expected_max_flow.RunRequest();
+        auto expected = expected_frames.TryPopAll();
+
+        Channel<Frame> frames(test % 3 + 1);
+        FrameRecorder recorder(&frames);
+        MaxFlow max_flow(n, edges);
+        recorder.Register(max_flow);
+        std::deque<Frame> received = frames.TryPopAll();
+        std::jthread solver([&max_flow](std::stop_token stop_token) {
+            max_flow.SolveRequest(stop_token);
+        });
+        while (auto frame = frames.Pop()) {
+            bool is_unlock = frame->is_unlock;
+            received.push_back(std::move(*frame));
+            if (is_unlock) {
+                break;
+            }
+        }
+        solver.join();
+        REQUIRE(frames.TryPopAll().empty());
+        REQUIRE(received == expected);
+    }
+}
@@ -0,0 +1,207 @@
+#include "catch.hpp"
+#include "../Kernel/dinic.h"
+#include "../Kernel/max_flow.h"
+#include "../Kernel/push_relabel.h"
+#include <limits>
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+using namespace observer_pattern;
+
+namespace {
+std::vector<BasicEdge> GenRandomEdges(std::mt19937_64& gen, size_t n, size_t m,
+                                      size_t max_capacity) {
+    std::vector<BasicEdge> edges;
+    while (edges.size() < m) {
+        size_t u = gen() % n, to = gen() % n;
+        if (u != to) {
+            edges.push_back({u, to, gen() % max_capacity + 1});
+        }
+    }
+    return edges;
+}
+
+template <class Capacity>
+std::vector<CapacityEdge<Capacity>> ConvertEdges(const std::vector<BasicEdge>& edges,
+                                                 Capacity scale) {
+    std::vector<CapacityEdge<Capacity>> result;
+    for (auto [u, to, delta] : edges) {
+        result.push_back({u, to, static_cast<Capacity>(delta) * scale});
+    }
+    return result;
+}
+
+size_t SolvePushRelabel(size_t n, const std::vector<BasicEdge>& edges) {
+    ResidualNetwork network(n, edges);
+    PushRelabel push_relabel;
+    return push_relabel.Run(network, 0, n - 1);
+}
+}  // namespace
+
+TEST_CASE("Dinic basic") {
+    BasicResidualNetwork<int32_t> network(
+        4, {{0, 1, 1}, {0, 2, 2}, {2, 1, 1}, {1, 3, 2}, {2, 3, 1}});
+    Dinic<int32_t> dinic;
+    REQUIRE(dinic.Run(network, 0, 3) == 3);
+    REQUIRE(network.GetFlow(0) == 1);
+    REQUIRE(network.GetFlow(3) == 2);
+    REQUIRE(network.GetFlow(4) == 1);
+}
+
+TEST_CASE("Dinic matches push-relabel") {
+    std::mt19937_64 gen(17);
+    Dinic<int32_t> dinic32;
+    Dinic<int64_t> dinic64;
+    Dinic<double> dinic_double;
+    for (size_t test = 0; test < 200; test++) {
+        size_t n = gen() % 30 + 2;
+        auto edges = GenRandomEdges(gen, n, gen() % (4 * n), 1000);
+        size_t expected = SolvePushRelabel(n, edges);
+        BasicResidualNetwork<int32_t> network32(n, ConvertEdges<int32_t>(edges, 1));
+        REQUIRE(dinic32.Run(network32, 0, n - 1) == static_cast<int32_t>(expected));
+        BasicResidualNetwork<int64_t> network64(n, ConvertEdges<int64_t>(edges, 1));
+        REQUIRE(dinic64.Run(network64, 0, n - 1) == static_cast<int64_t>(expected));
+        BasicResidualNetwork<double> network_double(n, ConvertEdges<double>(edges, 0.25));
+        REQUIRE(dinic_double.Run(network_double, 0, n - 1) ==
+                Approx(static_cast<double>(expected) * 0.25));
+    }
+}
+
+TEST_CASE("Dinic with capacities above 32 bits") {
+    std::mt19937_64 gen(19);
+    Dinic<int64_t> dinic;
+    for (size_t test = 0; test < 50; test++) {
+        size_t n = gen() % 20 + 2;
+        auto edges = GenRandomEdges(gen, n, gen() % (4 * n), size_t{1} << 50);
+        BasicResidualNetwork<int64_t> network(n, ConvertEdges<int64_t>(edges, 1));
+        REQUIRE(dinic.Run(network, 0, n - 1) ==
+                static_cast<int64_t>(SolvePushRelabel(n, edges)));
+    }
+}
+
+TEST_CASE("Dinic total flow above the capacity type") {
+    const int32_t capacity = std::numeric_limits<int32_t>::max();
+    std::vector<CapacityEdge<int32_t>> edges;
+    for (size_t i = 1; i <= 4; i++) {
+        edges.push_back({0, i, capacity});
+        edges.push_back({i, 5, capacity});
+    }
+    BasicResidualNetwork<int32_t> network(6, edges);
+    Dinic<int32_t> dinic;
+    REQUIRE(dinic.Run(network, 0, 5) == int64_t{4} * capacity);
+    Dinic<int32_t> dynamic_trees(BlockingFlow::DynamicTrees);
+    network.Build(6, edges);
+    REQUIRE(dynamic_trees.Run(network, 0, 5) == int64_t{4} * capacity);
+}
+
+TEST_CASE("Scaled MaxFlow with capacities above 32 bits") {
+    const size_t capacity = (size_t{1} << 40) + 3;
+    MaxFlow max_flow(4, {{0, 1, capacity}, {1, 3, capacity}, {0, 2, 5}, {2, 3, capacity}});
+    size_t pushed_flow = 0;
+    Observer<MaxFlowData> network_observer(
+        [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+    max_flow.RegisterNetworkObserver(&network_observer);
+    max_flow.RunRequest();
+    REQUIRE(pushed_flow == capacity + 5);
+}
+
+TEST_CASE("Direction-optimizing level graph") {
+    std::mt19937_64 gen(23);
+    Dinic<int64_t> top_down;
+    Dinic<int64_t> direction_optimizing(LevelGraphBuilder::DirectionOptimizing);
+    for (size_t test = 0; test < 200; test++) {
+        size_t n = gen() % 200 + 2;
+        auto edges = GenRandomEdges(gen, n, gen() % (8 * n), 100);
+        BasicResidualNetwork<int64_t> network(n, ConvertEdges<int64_t>(edges, 1));
+        int64_t expected = top_down.Run(network, 0, n - 1);
+        network.Build(n, ConvertEdges<int64_t>(edges, 1));
+        REQUIRE(direction_optimizing.Run(network, 0, n - 1) == expected);
+        REQUIRE(direction_optimizing.GetStatistics().phases == top_down.GetStatistics().phases);
+    }
+}
+
+TEST_CASE("Parallel level graph") {
+    std::mt19937_64 gen(29);
+    Dinic<int64_t> top_down;
+    Dinic<int64_t> parallel(LevelGraphBuilder::Parallel, 4);
+    for (size_t test = 0; test < 200; test++) {
+        size_t n = gen() % 2000 + 2;
+        auto edges = GenRandomEdges(gen, n, gen() % (8 * n), 100);
+        BasicResidualNetwork<int64_t> network(n, ConvertEdges<int64_t>(edges, 1));
+        int64_t expected = top_down.Run(network, 0, n - 1);
+        network.Build(n, ConvertEdges<int64_t>(edges, 1));
+        REQUIRE(parallel.Run(network, 0, n - 1) == expected);
+        REQUIRE(parallel.GetStatistics().phases == top_down.GetStatistics().phases);
+    }
+}
+
+TEST_CASE("Dynamic trees blocking flow") {
+    std::mt19937_64 gen(31);
+    Dinic<size_t> augmenting(BlockingFlow::Augmenting);
+    Dinic<size_t> dynamic_trees(BlockingFlow::DynamicTrees);
+    Dinic<int64_t> dynamic_trees64(BlockingFlow::DynamicTrees);
+    Dinic<double> dynamic_trees_double(BlockingFlow::DynamicTrees);
+    for (size_t test = 0; test < 300; test++) {
+        size_t n = gen() % 300 + 2;
+        auto edges = GenRandomEdges(gen, n, gen() % (4 * n), test % 2 ? 1 : 1000);
+        ResidualNetwork network(n, edges);
+        size_t expected = augmenting.Run(network, 0, n - 1);
+        network.Build(n, edges);
+        REQUIRE(dynamic_trees.Run(network, 0, n - 1) == expected);
+        std::vector<int64_t> balance(n);
+        for (size_t i = 0; i < edges.size(); i++) {
+            size_t flow = network.GetFlow(i);
+            REQUIRE(flow <= edges[i].delta);
+            balance[edges[i].u] -= static_cast<int64_t>(flow);
+            balance[edges[i].to] += static_cast<int64_t>(flow);
+        }
+        REQUIRE(balance[n - 1] == static_cast<int64_t>(expected));
+        for (size_t vertex = 1; vertex + 1 < n; vertex++) {
+            REQUIRE(balance[vertex] == 0);
+        }
+        BasicResidualNetwork<int64_t> network64(n, ConvertEdges<int64_t>(edges, 1));
+        REQUIRE(dynamic_trees64.Run(network64, 0, n - 1) == static_cast<int64_t>(expected));
+        BasicResidualNetwork<double> network_double(n, ConvertEdges<double>(edges, 0.25));
+        REQUIRE(dynamic_trees_double.Run(network_double, 0, n - 1) ==
+                Approx(static_cast<double>(expected) * 0.25));
+    }
+}
+
+TEST_CASE("Dynamic trees on a long path") {
+    const size_t n = 100000;
+    std::vector<BasicEdge> edges;
+    for (size_t i = 0; i + 1 < n; i++) {
+        edges.push_back({i, i + 1, n - i});
+        if (i % 3 == 0 && i + 2 < n) {
+            edges.push_back({i, i + 2, 1});
+        }
+    }
+    ResidualNetwork network(n, edges);
+    Dinic<size_t> dynamic_trees(BlockingFlow::DynamicTrees);
+    REQUIRE(dynamic_trees.Run(network, 0, n - 1) == SolvePushRelabel(n, edges));
+}
+
+TEST_CASE("Adaptive blocking flow on a shared corridor") {
+    const size_t length = 2000, fan = 500;
+    std::vector<BasicEdge> edges;
+    for (size_t vertex = 0; vertex < length; vertex++) {
+        edges.push_back({vertex, vertex + 1, fan});
+    }
+    for (size_t i = 1; i <= fan; i++) {
+        edges.push_back({length, length + i, 1});
+        edges.push_back({length + i, length + fan + 1, 1});
+    }
+    size_t n = length + fan + 2;
+    ResidualNetwork network(n, edges);
+    Dinic<size_t> augmenting(BlockingFlow::Augmenting);
+    REQUIRE(augmenting.Run(network, 0, n - 1) == fan);
+    REQUIRE(augmenting.GetStatistics().dynamic_tree_phases == 0);
+    network.Build(n, edges);
+    Dinic<size_t> adaptive;
+    REQUIRE(adaptive.Run(network, 0, n - 1) == fan);
+    REQUIRE(adaptive.GetStatistics().dynamic_tree_phases > 0);
+    for (size_t i = 0; i < edges.size(); i++) {
+        REQUIRE(network.GetFlow(i) == (i < length ? fan : 1));
+    }
+}
@@ -0,0 +1,95 @@
+#include "catch.hpp"
+#include "../Kernel/gomory_hu.h"
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+namespace {
+size_t SolveUndirected(size_t n, const std::vector<BasicEdge>& edges, size_t source,
+                       size_t sink) {
+    std::vector<BasicEdge> arcs;
+    for (auto [u, to, delta] : edges) {
+        arcs.push_back({u, to, delta});
+        arcs.push_back({to, u, delta});
+    }
+    ResidualNetwork network(n, arcs);
+    Dinic<size_t> dinic;
+    return dinic.Run(network, source, sink);
+}
+
+bool IsInSubtree(const GomoryHuTree& tree, size_t vertex, size_t root) {
+    for (size_t depth = 0; depth < tree.GetVerticesNumber(); depth++) {
+        if (vertex == root) {
+            return true;
+        }
+        if (!vertex) {
+            return false;
+        }
+        vertex = tree.GetParent(vertex);
+    }
+    return false;
+}
+}  // namespace
+
+TEST_CASE("Gomory-Hu basic") {
+    GomoryHuTree tree(1);
+    tree.Build(4, {{0, 1, 3}, {1, 2, 1}, {2, 3, 4}, {3, 0, 2}});
+    REQUIRE(tree.GetMinCut(0, 1) == 4);
+    REQUIRE(tree.GetMinCut(0, 2) == 3);
+    REQUIRE(tree.GetMinCut(1, 2) == 3);
+    REQUIRE(tree.GetMinCut(2, 3) == 5);
+}
+
+TEST_CASE("Gomory-Hu matches pairwise max flow") {
+    std::mt19937 gen(41);
+    GomoryHuTree sequential_tree(1);
+    GomoryHuTree parallel_tree(4);
+    for (size_t test = 0; test < 50; test++) {
+        size_t n = gen() % 20 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 2 * n; i++) {
+            size_t u = gen() % n, to = gen() % n;
+            if (u != to) {
+                edges.push_back({u, to, gen() % 20 + 1});
+            }
+        }
+        sequential_tree.Build(n, edges);
+        parallel_tree.Build(n, edges);
+        auto cuts = parallel_tree.GetAllPairsMinCuts();
+        for (size_t u = 0; u < n; u++) {
+            for (size_t v = u + 1; v < n; v++) {
+                size_t expected = SolveUndirected(n, edges, u, v);
+                REQUIRE(sequential_tree.GetMinCut(u, v) == expected);
+                REQUIRE(parallel_tree.GetMinCut(u, v) == expected);
+                REQUIRE(cuts[u][v] == expected);
+                REQUIRE(cuts[v][u] == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Gomory-Hu tree edges are minimum cuts") {
+    std::mt19937 gen(43);
+    GomoryHuTree tree(3);
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 20 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 2 * n; i++) {
+            size_t u = gen() % n, to = gen() % n;
+            if (u != to) {
+                edges.push_back({u, to, gen() % 20 + 1});
+            }
+        }
+        tree.Build(n, edges);
+        for (size_t vertex = 1; vertex < n; vertex++) {
+            size_t cut = 0;
+            for (auto [u, to, delta] : edges) {
+                if (IsInSubtree(tree, u, vertex) != IsInSubtree(tree, to, vertex)) {
+                    cut += delta;
+                }
+            }
+            REQUIRE(cut == tree.GetWeight(vertex));
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#include "catch.hpp"
+#include "../Kernel/hopcroft_karp.h"
+#include "../Kernel/max_flow.h"
+#include "../Kernel/push_relabel.h"
+#include <algorithm>
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+using namespace observer_pattern;
+
+namespace {
+using MatchingEdge = HopcroftKarp::Edge;
+
+std::vector<MatchingEdge> GenBipartiteGraph(std::mt19937& gen, size_t left_number,
+                                            size_t right_number, size_t edges_number) {
+    std::vector<MatchingEdge> edges;
+    for (size_t i = 0; i < edges_number; i++) {
+        edges.push_back({gen() % left_number, gen() % right_number});
+    }
+    return edges;
+}
+
+std::vector<BasicEdge> GetFlowNetwork(size_t left_number, size_t right_number,
+                                      const std::vector<MatchingEdge>& edges) {
+    size_t sink = left_number + right_number + 1;
+    std::vector<BasicEdge> network;
+    for (size_t i = 0; i < left_number; i++) {
+        network.push_back({0, i + 1, 1});
+    }
+    for (auto [left, right] : edges) {
+        network.push_back({left + 1, left_number + right + 1, 1});
+    }
+    for (size_t i = 0; i < right_number; i++) {
+        network.push_back({left_number + i + 1, sink, 1});
+    }
+    return network;
+}
+
+size_t SolveFlowNetwork(size_t left_number, size_t right_number,
+                        const std::vector<MatchingEdge>& edges) {
+    ResidualNetwork network(left_number + right_number + 2,
+                            GetFlowNetwork(left_number, right_number, edges));
+    PushRelabel push_relabel;
+    return push_relabel.Run(network, 0, left_number + right_number + 1);
+}
+
+void CheckMatching(size_t right_number, const std::vector<MatchingEdge>& edges,
+                   const std::vector<size_t>& matched_edges, size_t matching) {
+    std::vector<bool> is_matched(right_number);
+    size_t size = 0;
+    for (size_t vertex = 0; vertex < matched_edges.size(); vertex++) {
+        if (matched_edges[vertex] == HopcroftKarp::kNone) {
+            continue;
+        }
+        const auto& edge = edges[matched_edges[vertex]];
+        REQUIRE(edge.left == vertex);
+        REQUIRE(!is_matched[edge.right]);
+        is_matched[edge.right] = true;
+        size++;
+    }
+    REQUIRE(size == matching);
+}
+}  // namespace
+
+TEST_CASE("Hopcroft-Karp basic") {
+    HopcroftKarp hopcroft_karp;
+    std::vector<MatchingEdge> edges = {{0, 0}, {0, 1}, {1, 0}, {2, 1}, {2, 2}, {3, 2}};
+    std::vector<size_t> matched_edges(4, HopcroftKarp::kNone);
+    REQUIRE(hopcroft_karp.Run(4, 3, edges, matched_edges) == 3);
+    CheckMatching(3, edges, matched_edges, 3);
+}
+
+TEST_CASE("Hopcroft-Karp matches push-relabel") {
+    std::mt19937 gen(17);
+    HopcroftKarp hopcroft_karp;
+    for (size_t test = 0; test < 200; test++) {
+        size_t left_number = gen() % 30 + 1, right_number = gen() % 30 + 1;
+        auto edges = GenBipartiteGraph(gen, left_number, right_number, gen() % 100);
+        std::vector<size_t> matched_edges(left_number, HopcroftKarp::kNone);
+        size_t matching = hopcroft_karp.Run(left_number, right_number, edges, matched_edges);
+        REQUIRE(matching == SolveFlowNetwork(left_number, right_number, edges));
+        CheckMatching(right_number, edges, matched_edges, matching);
+    }
+}
+
+TEST_CASE("Hopcroft-Karp extends initial matching") {
+    std::mt19937 gen(19);
+    HopcroftKarp hopcroft_karp;
+    for (size_t test = 0; test < 100; test++) {
+        size_t left_number = gen() % 30 + 1, right_number = gen() % 30 + 1;
+        auto edges = GenBipartiteGraph(gen, left_number, right_number, gen() % 100);
+        std::vector<size_t> matched_edges(left_number, HopcroftKarp::kNone);
+        std::vector<bool> is_matched(right_number);
+        for (size_t i = 0; i < edges.size(); i++) {
+            auto [left, right] = edges[i];
+            if (matched_edges[left] == HopcroftKarp::kNone && !is_matched[right] && gen() % 2) {
+                matched_edges[left] = i;
+                is_matched[right] = true;
+            }
+        }
+        size_t matching = hopcroft_karp.Run(left_number, right_number, edges, matched_edges);
+        REQUIRE(matching == SolveFlowNetwork(left_number, right_number, edges));
+        CheckMatching(right_number, edges, matched_edges, matching);
+        REQUIRE(hopcroft_karp.Run(left_number, right_number, edges, matched_edges) == matching);
+    }
+}
+
+TEST_CASE("Test matching network") {
+    std::mt19937 gen(23);
+    for (size_t test = 0; test < 100; test++) {
+        size_t left_number = gen() % 10 + 1, right_number = gen() % 10 + 1;
+        size_t n = left_number + right_number + 2;
+        std::vector<MatchingEdge> edges;
+        std::vector<bool> is_added(left_number * right_number);
+        for (auto edge : GenBipartiteGraph(gen, left_number, right_number, gen() % 30 + 1)) {
+            if (!is_added[edge.left * right_number + edge.right]) {
+                is_added[edge.left * right_number + edge.right] = true;
+                edges.push_back(edge);
+            }
+        }
+        auto network = GetFlowNetwork(left_number, right_number, edges);
+        MaxFlow max_flow(n, network);
+        MaxFlowData last_message;
+        Observer<MaxFlowData> network_observer(
+            [&last_message](const MaxFlowData& message) { last_message = message; });
+        max_flow.RegisterNetworkObserver(&network_observer);
+        for (size_t round = 0; round < 3; round++) {
+            max_flow.RunRequest(gen() % 2 ? Engine::Dinic : Engine::PushRelabel);
+            MaxFlow expected_max_flow(n, network);
+            expected_max_flow.RunRequest(Engine::BoykovKolmogorov);
+            REQUIRE(last_message.pushed_flow == expected_max_flow.GetMinCut().capacity);
+            REQUIRE(max_flow.GetMinCut().capacity == last_message.pushed_flow);
+            std::vector<int64_t> balance(n);
+            for (size_t i = 0; i < last_message.edges.size(); i += 2) {
+                const auto& edge = last_message.edges[i];
+                REQUIRE(edge.delta <= 1);
+                balance[edge.u] -= 1 - static_cast<int64_t>(edge.delta);
+                balance[edge.to] += 1 - static_cast<int64_t>(edge.delta);
+            }
+            REQUIRE(balance[n - 1] == static_cast<int64_t>(last_message.pushed_flow));
+            for (size_t vertex = 1; vertex + 1 < n; vertex++) {
+                REQUIRE(balance[vertex] == 0);
+            }
+            const auto& deleted = network[gen() % network.size()];
+            max_flow.DeleteEdgeRequest(deleted);
+            network.erase(std::find_if(network.begin(), network.end(), [&](const auto& edge) {
+                return edge.u == deleted.u && edge.to == deleted.to;
+            }));
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include "catch.hpp"
+#include "../Kernel/link_cut_tree.h"
+#include <random>
+
+using namespace max_flow_app;
+
+TEST_CASE("Link-cut tree matches naive forest") {
+    std::mt19937 gen(37);
+    const int64_t infinity = LinkCutTree<int64_t>::kInfinity;
+    for (size_t test = 0; test < 50; test++) {
+        size_t n = gen() % 50 + 2;
+        LinkCutTree<int64_t> forest;
+        forest.Reset(n);
+        std::vector<size_t> parents(n, n);
+        std::vector<int64_t> values(n, infinity);
+        auto find_root = [&](size_t vertex) {
+            while (parents[vertex] != n) {
+                vertex = parents[vertex];
+            }
+            return vertex;
+        };
+        for (size_t step = 0; step < 2000; step++) {
+            size_t vertex = gen() % n;
+            size_t root = find_root(vertex);
+            REQUIRE(forest.FindRoot(vertex) == root);
+            switch (gen() % 4) {
+                case 0: {
+                    size_t parent = gen() % n;
+                    if (parents[vertex] == n && find_root(parent) != vertex) {
+                        values[vertex] = gen() % 100;
+                        parents[vertex] = parent;
+                        forest.Link(vertex, parent, values[vertex]);
+                    }
+                    break;
+                }
+                case 1:
+                    if (parents[vertex] != n) {
+                        REQUIRE(forest.Cut(vertex) == values[vertex]);
+                        parents[vertex] = n;
+                        values[vertex] = infinity;
+                    }
+                    break;
+                case 2: {
+                    int64_t min = infinity;
+                    for (size_t cur = vertex; cur != root; cur = parents[cur]) {
+                        min = std::min(min, values[cur]);
+                    }
+                    if (vertex == root) {
+                        break;
+                    }
+                    auto [value, min_vertex] = forest.FindMin(vertex);
+                    REQUIRE(value == min);
+                    REQUIRE(values[min_vertex] == min);
+                    int64_t delta = static_cast<int64_t>(gen() % (min + 1));
+                    forest.SubtractFromPath(vertex, delta);
+                    for (size_t cur = vertex; cur != root; cur = parents[cur]) {
+                        values[cur] -= delta;
+                    }
+                    forest.SetValue(root, infinity);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+}
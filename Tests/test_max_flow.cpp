@@ -1,6 +1,9 @@
 #include "catch.hpp"
 #include "../Kernel/max_flow.h"
+#include <algorithm>
 #include <iostream>
+#include <random>
+#include <tuple>
 
 using namespace max_flow_app;
 using namespace kernel_messages;
@@ -770,3 +773,428 @@ TEST_CASE("Test basic") {
     max_flow.AddEdgeRequest({2, 3, 1});
     max_flow.RunRequest();
 }
+
+TEST_CASE("Test deep network") {
+    const size_t n = 200000;
+    std::vector<BasicEdge> edges;
+    for (size_t i = 0; i + 1 < n; i++) {
+        edges.push_back({i, i + 1, 3});
+    }
+    edges.push_back({0, n - 1, 1});
+    MaxFlow max_flow(n, edges);
+    size_t pushed_flow = 0;
+    Observer<MaxFlowData> network_observer(
+        [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+    max_flow.RegisterNetworkObserver(&network_observer);
+    max_flow.RunRequest();
+    REQUIRE(pushed_flow == 4);
+}
+
+TEST_CASE("Test incremental add") {
+    std::mt19937 gen(3);
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 10 + 2;
+        MaxFlow max_flow;
+        MaxFlow expected_max_flow;
+        MaxFlowData last_message, expected_message;
+        Observer<MaxFlowData> network_observer(
+            [&last_message](const MaxFlowData& message) { last_message = message; });
+        Observer<MaxFlowData> expected_network_observer(
+            [&expected_message](const MaxFlowData& message) { expected_message = message; });
+        max_flow.RegisterNetworkObserver(&network_observer);
+        expected_max_flow.RegisterNetworkObserver(&expected_network_observer);
+        max_flow.ChangeVerticesNumberRequest(n);
+        expected_max_flow.ChangeVerticesNumberRequest(n);
+        for (size_t i = 0; i < 3 * n; i++) {
+            BasicEdge edge{gen() % n, gen() % n, gen() % 20 + 1};
+            size_t flow = last_message.pushed_flow;
+            max_flow.AddEdgeRequest(edge);
+            REQUIRE(last_message.pushed_flow == flow);
+            if (gen() % 2) {
+                max_flow.RunRequest();
+            }
+            expected_max_flow.AddEdgeRequest(edge);
+        }
+        max_flow.RunRequest();
+        expected_max_flow.RunRequest();
+        REQUIRE(last_message.pushed_flow == expected_message.pushed_flow);
+    }
+}
+
+TEST_CASE("Test delete after run") {
+    std::mt19937 gen(7);
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 10 + 2;
+        MaxFlow max_flow;
+        MaxFlow expected_max_flow;
+        MaxFlowData last_message, expected_message;
+        Observer<MaxFlowData> network_observer(
+            [&last_message](const MaxFlowData& message) { last_message = message; });
+        Observer<MaxFlowData> expected_network_observer(
+            [&expected_message](const MaxFlowData& message) { expected_message = message; });
+        max_flow.RegisterNetworkObserver(&network_observer);
+        expected_max_flow.RegisterNetworkObserver(&expected_network_observer);
+        max_flow.ChangeVerticesNumberRequest(n);
+        expected_max_flow.ChangeVerticesNumberRequest(n);
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 3 * n; i++) {
+            BasicEdge edge{gen() % n, gen() % n, gen() % 20 + 1};
+            max_flow.AddEdgeRequest(edge);
+            expected_max_flow.AddEdgeRequest(edge);
+            edges.push_back(edge);
+        }
+        max_flow.RunRequest();
+        for (size_t i = 0; i < n; i++) {
+            const auto& edge = edges[gen() % edges.size()];
+            size_t flow = last_message.pushed_flow;
+            max_flow.DeleteEdgeRequest(edge);
+            REQUIRE(last_message.pushed_flow <= flow);
+            if (gen() % 2) {
+                max_flow.RunRequest();
+            }
+            expected_max_flow.DeleteEdgeRequest(edge);
+        }
+        max_flow.RunRequest();
+        expected_max_flow.RunRequest();
+        REQUIRE(last_message.pushed_flow == expected_message.pushed_flow);
+    }
+}
+
+TEST_CASE("Test bulk delete after run") {
+    std::mt19937 gen(13);
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 30 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t u = 0; u < n; u++) {
+            for (size_t to = u + 1; to < n; to++) {
+                if (gen() % 4 == 0) {
+                    edges.push_back({u, to, gen() % 20 + 1});
+                }
+            }
+        }
+        MaxFlow max_flow(n, edges);
+        max_flow.RunRequest();
+        std::shuffle(edges.begin(), edges.end(), gen);
+        size_t deleted = gen() % (edges.size() + 1);
+        max_flow.DeleteEdgesRequest({edges.begin(), edges.begin() + deleted});
+        max_flow.RunRequest();
+        MaxFlow expected_max_flow(n, {edges.begin() + deleted, edges.end()});
+        expected_max_flow.RunRequest();
+        REQUIRE(max_flow.GetMinCut().capacity == expected_max_flow.GetMinCut().capacity);
+    }
+}
+
+TEST_CASE("Test cancelled solve") {
+    std::mt19937 gen(17);
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 40 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 4 * n; i++) {
+            size_t u = gen() % n, to = gen() % n;
+            if (u != to) {
+                edges.push_back({u, to, gen() % 1000 + 1});
+            }
+        }
+        MaxFlow expected_max_flow(n, edges);
+        expected_max_flow.RunRequest();
+        size_t expected = expected_max_flow.GetMinCut().capacity;
+
+        MaxFlow max_flow(n, edges);
+        std::stop_source stop_source;
+        size_t notifications = 0, limit = gen() % 200;
+        Observer<MaxFlowData> flow_observer([&](const MaxFlowData&) {
+            if (++notifications > limit) {
+                stop_source.request_stop();
+            }
+        });
+        max_flow.RegisterFlowObserver(&flow_observer);
+        auto result = max_flow.SolveRequest(stop_source.get_token());
+        REQUIRE(result.flow <= expected);
+        REQUIRE(result.upper_bound >= expected);
+        if (result.is_complete) {
+            REQUIRE(result.flow == expected);
+            REQUIRE(result.upper_bound == expected);
+        }
+        flow_observer.Unsubscribe();
+        max_flow.RunRequest();
+        REQUIRE(max_flow.GetMinCut().capacity == expected);
+
+        MaxFlow expired_max_flow(n, edges);
+        auto expired = expired_max_flow.SolveRequest(std::stop_token(), MaxFlow::Clock::now());
+        REQUIRE(expired.flow == 0);
+        REQUIRE(expired.upper_bound >= expected);
+        REQUIRE(expired.is_complete == (expected == 0));
+    }
+}
+
+TEST_CASE("Test edge edits") {
+    struct Arc {
+        size_t u, to, delta;
+        int64_t cost;
+    };
+    std::mt19937 gen(11);
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 10 + 2;
+        bool is_headless = test % 2;
+        MaxFlow max_flow;
+        MaxFlowData last_message;
+        Observer<MaxFlowData> network_observer(
+            [&last_message](const MaxFlowData& message) { last_message = message; });
+        if (!is_headless) {
+            max_flow.RegisterNetworkObserver(&network_observer);
+        }
+        max_flow.ChangeVerticesNumberRequest(n);
+        std::vector<Arc> arcs;
+        std::vector<std::pair<size_t, std::vector<Arc>>> history{{2, {}}};
+        auto find_arc = [&arcs](size_t u, size_t to) {
+            auto it = std::find_if(arcs.begin(), arcs.end(),
+                                   [u, to](const Arc& arc) { return arc.u == u && arc.to == to; });
+            return static_cast<size_t>(it - arcs.begin());
+        };
+        auto delete_arc = [&arcs, &find_arc](size_t u, size_t to) {
+            size_t index = find_arc(u, to);
+            if (index != arcs.size()) {
+                index &= ~size_t{1};
+                arcs.erase(arcs.begin() + index, arcs.begin() + index + 2);
+            }
+        };
+        auto check_arcs = [&last_message, &arcs]() {
+            REQUIRE(last_message.edges.size() == arcs.size());
+            for (size_t j = 0; j < arcs.size(); j++) {
+                REQUIRE(last_message.edges[j].u == arcs[j].u);
+                REQUIRE(last_message.edges[j].to == arcs[j].to);
+                REQUIRE(last_message.edges[j].delta == arcs[j].delta);
+            }
+        };
+        for (size_t i = 0; i < 200; i++) {
+            size_t type = gen() % 10;
+            if (type < 5) {
+                BasicEdge edge{gen() % n, gen() % n, gen() % 20 + 1};
+                int64_t cost = gen() % 2;
+                max_flow.AddEdgeRequest(edge, cost);
+                if (edge.u == edge.to) {
+                    continue;
+                }
+                history.push_back({n, arcs});
+                size_t index = find_arc(edge.u, edge.to);
+                if (index == arcs.size() || arcs[index].cost != cost) {
+                    arcs.push_back({edge.u, edge.to, edge.delta, cost});
+                    arcs.push_back({edge.to, edge.u, 0, -cost});
+                } else {
+                    arcs[index].delta += edge.delta;
+                }
+            } else if (type < 7) {
+                BasicEdge edge{gen() % n, gen() % n, 1};
+                max_flow.DeleteEdgeRequest(edge);
+                history.push_back({n, arcs});
+                delete_arc(edge.u, edge.to);
+            } else if (type < 8) {
+                std::vector<BasicEdge> edges(gen() % 8);
+                for (auto& edge : edges) {
+                    edge = {gen() % n, gen() % n, 1};
+                }
+                max_flow.DeleteEdgesRequest(edges);
+                history.push_back({n, arcs});
+                for (const auto& edge : edges) {
+                    delete_arc(edge.u, edge.to);
+                }
+            } else if (type < 9) {
+                size_t new_number = gen() % 10 + 2;
+                max_flow.ChangeVerticesNumberRequest(new_number);
+                history.push_back({n, arcs});
+                std::erase_if(arcs, [new_number](const Arc& arc) {
+                    return arc.u >= new_number || arc.to >= new_number;
+                });
+                n = new_number;
+            } else {
+                max_flow.RecoverPrevStateRequest();
+                if (!history.empty()) {
+                    std::tie(n, arcs) = history.back();
+                    history.pop_back();
+                }
+            }
+            if (history.size() > 10) {
+                history.erase(history.begin());
+            }
+            if (!is_headless) {
+                check_arcs();
+            }
+        }
+        if (is_headless) {
+            max_flow.RegisterNetworkObserver(&network_observer);
+            check_arcs();
+        }
+    }
+}
+
+TEST_CASE("Test undo of edits with flow") {
+    using Arcs = std::vector<std::tuple<size_t, size_t, size_t>>;
+    std::mt19937 gen(23);
+    for (size_t test = 0; test < 50; test++) {
+        size_t n = gen() % 12 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 4 * n; i++) {
+            edges.push_back({gen() % n, gen() % n, gen() % 20 + 1});
+        }
+        std::erase_if(edges, [](const BasicEdge& edge) { return edge.u == edge.to; });
+        MaxFlow max_flow(n, edges);
+        MaxFlowData last_message;
+        Observer<MaxFlowData> network_observer(
+            [&last_message](const MaxFlowData& message) { last_message = message; });
+        max_flow.RegisterNetworkObserver(&network_observer);
+        max_flow.RunRequest();
+        auto get_state = [&last_message]() {
+            Arcs arcs;
+            for (const auto& edge : last_message.edges) {
+                arcs.emplace_back(edge.u, edge.to, edge.delta);
+            }
+            return std::make_pair(last_message.pushed_flow, arcs);
+        };
+        std::vector<std::pair<size_t, Arcs>> history;
+        for (size_t i = 0; i < 300; i++) {
+            size_t type = gen() % 10;
+            if (type == 9) {
+                max_flow.RecoverPrevStateRequest();
+                if (!history.empty()) {
+                    REQUIRE(get_state() == history.back());
+                    history.pop_back();
+                }
+                continue;
+            }
+            history.push_back(get_state());
+            if (history.size() > 10) {
+                history.erase(history.begin());
+            }
+            if (type < 3) {
+                size_t u = gen() % n, to = (u + gen() % (n - 1) + 1) % n;
+                max_flow.AddEdgeRequest({u, to, gen() % 20 + 1}, gen() % 2);
+            } else if (type < 6) {
+                max_flow.DeleteEdgeRequest(edges[gen() % edges.size()]);
+            } else if (type < 8) {
+                std::vector<BasicEdge> deleted(gen() % (2 * n));
+                for (auto& edge : deleted) {
+                    edge = edges[gen() % edges.size()];
+                }
+                max_flow.DeleteEdgesRequest(deleted);
+            } else {
+                max_flow.RunRequest(gen() % 2 ? Engine::Dinic : Engine::BoykovKolmogorov);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test min cut") {
+    std::mt19937 gen(11);
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 10 + 2;
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 3 * n; i++) {
+            size_t u = gen() % n, to = gen() % n;
+            if (u != to) {
+                edges.push_back({u, to, gen() % 20 + 1});
+            }
+        }
+        MaxFlow max_flow(n, edges);
+        size_t pushed_flow = 0;
+        Observer<MaxFlowData> network_observer(
+            [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+        max_flow.RegisterNetworkObserver(&network_observer);
+        max_flow.RunRequest(test % 2 ? Engine::Dinic : Engine::BoykovKolmogorov);
+        auto cut = max_flow.GetMinCut();
+        REQUIRE(cut.source_side.Size() == n);
+        REQUIRE(cut.source_side.Test(0));
+        REQUIRE(!cut.source_side.Test(n - 1));
+        REQUIRE(cut.capacity == pushed_flow);
+        size_t capacity = 0;
+        for (const auto& edge : edges) {
+            if (cut.source_side.Test(edge.u) && !cut.source_side.Test(edge.to)) {
+                capacity += edge.delta;
+            }
+        }
+        REQUIRE(capacity == cut.capacity);
+    }
+}
+
+TEST_CASE("Test multiple terminals") {
+    std::mt19937 gen(13);
+    const std::vector<Engine> engines = {Engine::Dinic, Engine::PushRelabel,
+                                         Engine::ParallelPushRelabel, Engine::BoykovKolmogorov,
+                                         Engine::MinCostFlow, Engine::DirectionOptimizingDinic,
+                                         Engine::ParallelDinic};
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 10 + 3;
+        std::vector<BasicEdge> edges;
+        for (size_t i = 0; i < 3 * n; i++) {
+            size_t u = gen() % n, to = gen() % n;
+            if (u != to) {
+                edges.push_back({u, to, gen() % 20 + 1});
+            }
+        }
+        std::vector<size_t> order(n);
+        for (size_t i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        std::shuffle(order.begin(), order.end(), gen);
+        size_t sources_number = gen() % (n - 1) + 1;
+        size_t sinks_number = gen() % (n - sources_number) + 1;
+        std::vector<size_t> sources(order.begin(), order.begin() + sources_number);
+        std::vector<size_t> sinks(order.begin() + sources_number,
+                                  order.begin() + sources_number + sinks_number);
+
+        std::vector<BasicEdge> expected_edges;
+        for (auto [u, to, delta] : edges) {
+            expected_edges.push_back({u + 1, to + 1, delta});
+        }
+        for (size_t source : sources) {
+            expected_edges.push_back({0, source + 1, 1000});
+        }
+        for (size_t sink : sinks) {
+            expected_edges.push_back({sink + 1, n + 1, 1000});
+        }
+        MaxFlow expected_max_flow(n + 2, expected_edges);
+        size_t expected_flow = 0;
+        Observer<MaxFlowData> expected_network_observer(
+            [&expected_flow](const MaxFlowData& message) { expected_flow = message.pushed_flow; });
+        expected_max_flow.RegisterNetworkObserver(&expected_network_observer);
+        expected_max_flow.RunRequest();
+
+        for (auto engine : engines) {
+            MaxFlow max_flow(n, edges);
+            size_t pushed_flow = 0;
+            Observer<MaxFlowData> network_observer(
+                [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+            max_flow.RegisterNetworkObserver(&network_observer);
+            max_flow.SetTerminalsRequest(sources, sinks);
+            max_flow.RunRequest(engine);
+            REQUIRE(pushed_flow == expected_flow);
+            auto cut = max_flow.GetMinCut();
+            REQUIRE(cut.capacity == expected_flow);
+            for (size_t sink : sinks) {
+                REQUIRE(!cut.source_side.Test(sink));
+            }
+        }
+    }
+}
+
+TEST_CASE("Test terminals change") {
+    MaxFlow max_flow(4, {{0, 1, 3}, {1, 2, 2}, {2, 3, 5}, {3, 0, 1}});
+    size_t pushed_flow = 0;
+    Observer<MaxFlowData> network_observer(
+        [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+    max_flow.RegisterNetworkObserver(&network_observer);
+    max_flow.RunRequest();
+    REQUIRE(pushed_flow == 2);
+    max_flow.SetTerminalsRequest(2, 1);
+    max_flow.RunRequest();
+    REQUIRE(pushed_flow == 1);
+    max_flow.SetTerminalsRequest(1, 1);
+    max_flow.RunRequest();
+    REQUIRE(pushed_flow == 1);
+    max_flow.SetTerminalsRequest(3, 2);
+    max_flow.RunRequest(Engine::PushRelabel);
+    REQUIRE(pushed_flow == 1);
+    max_flow.RecoverPrevStateRequest();
+    max_flow.RecoverPrevStateRequest();
+    max_flow.RunRequest(Engine::BoykovKolmogorov);
+    REQUIRE(pushed_flow == 1);
+}
@@ -0,0 +1,152 @@
+#include "catch.hpp"
+#include "../Kernel/max_flow.h"
+#include "../Kernel/min_cost_flow.h"
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+using namespace observer_pattern;
+
+namespace {
+struct CostNetwork {
+    std::vector<Edge> edges;
+    std::vector<int64_t> costs;
+
+    void AddEdge(size_t u, size_t to, size_t capacity, int64_t cost) {
+        edges.push_back({.u = u, .to = to, .delta = capacity});
+        edges.push_back({.u = to, .to = u, .delta = 0});
+        costs.push_back(cost);
+        costs.push_back(-cost);
+    }
+};
+
+CostNetwork GenRandomNetwork(std::mt19937& gen, size_t n, size_t m, bool is_acyclic) {
+    CostNetwork network;
+    while (network.edges.size() < 2 * m) {
+        size_t u = gen() % n, to = gen() % n;
+        if (u == to || (is_acyclic && u > to)) {
+            continue;
+        }
+        int64_t cost = is_acyclic ? static_cast<int64_t>(gen() % 41) - 20 : gen() % 20;
+        network.AddEdge(u, to, gen() % 20 + 1, cost);
+    }
+    return network;
+}
+
+bool HasNegativeCycle(size_t n, const CostNetwork& network) {
+    std::vector<int64_t> distances(n);
+    for (size_t iteration = 0; iteration < n; iteration++) {
+        bool is_relaxed = false;
+        for (size_t i = 0; i < network.edges.size(); i++) {
+            const auto& edge = network.edges[i];
+            if (edge.delta && distances[edge.u] + network.costs[i] < distances[edge.to]) {
+                distances[edge.to] = distances[edge.u] + network.costs[i];
+                is_relaxed = true;
+            }
+        }
+        if (!is_relaxed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t SolveMaxFlow(size_t n, const CostNetwork& network) {
+    std::vector<BasicEdge> edges;
+    for (size_t i = 0; i < network.edges.size(); i += 2) {
+        edges.push_back({network.edges[i].u, network.edges[i].to, network.edges[i].delta});
+    }
+    MaxFlow max_flow(n, edges);
+    size_t pushed_flow = 0;
+    Observer<MaxFlowData> network_observer(
+        [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+    max_flow.RegisterNetworkObserver(&network_observer);
+    max_flow.RunRequest();
+    return pushed_flow;
+}
+
+int64_t GetCost(const CostNetwork& network, const CostNetwork& initial) {
+    int64_t cost = 0;
+    for (size_t i = 0; i < network.edges.size(); i += 2) {
+        cost += network.costs[i] * static_cast<int64_t>(initial.edges[i].delta -
+                                                        network.edges[i].delta);
+    }
+    return cost;
+}
+}  // namespace
+
+TEST_CASE("Min-cost flow basic") {
+    CostNetwork network;
+    network.AddEdge(0, 1, 2, 1);
+    network.AddEdge(0, 2, 2, 5);
+    network.AddEdge(1, 2, 1, 1);
+    network.AddEdge(1, 3, 1, 6);
+    network.AddEdge(2, 3, 3, 1);
+    auto initial = network;
+    MinCostFlow min_cost_flow;
+    REQUIRE(min_cost_flow.Run(4, network.edges, network.costs, 0, 3) == 4);
+    REQUIRE(GetCost(network, initial) == 3 + 7 + 12);
+}
+
+TEST_CASE("Min-cost flow is maximal and optimal") {
+    std::mt19937 gen(5);
+    MinCostFlow min_cost_flow;
+    for (size_t test = 0; test < 200; test++) {
+        size_t n = gen() % 20 + 2;
+        auto network = GenRandomNetwork(gen, n, gen() % (4 * n), test % 2);
+        size_t expected = SolveMaxFlow(n, network);
+        REQUIRE(min_cost_flow.Run(n, network.edges, network.costs, 0, n - 1) == expected);
+        REQUIRE(!HasNegativeCycle(n, network));
+    }
+}
+
+TEST_CASE("Min-cost flow engine") {
+    std::mt19937 gen(9);
+    for (size_t test = 0; test < 50; test++) {
+        size_t n = gen() % 10 + 2;
+        auto network = GenRandomNetwork(gen, n, 3 * n, false);
+        auto initial = network;
+        MinCostFlow min_cost_flow;
+        size_t expected_flow = *min_cost_flow.Run(n, network.edges, network.costs, 0, n - 1);
+        MaxFlow max_flow;
+        size_t pushed_flow = 0;
+        Observer<MaxFlowData> network_observer(
+            [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+        max_flow.RegisterNetworkObserver(&network_observer);
+        max_flow.ChangeVerticesNumberRequest(n);
+        for (size_t i = 0; i < initial.edges.size(); i += 2) {
+            const auto& edge = initial.edges[i];
+            max_flow.AddEdgeRequest({edge.u, edge.to, edge.delta}, initial.costs[i]);
+        }
+        max_flow.RunRequest();
+        max_flow.RunRequest(Engine::MinCostFlow);
+        REQUIRE(pushed_flow == expected_flow);
+        REQUIRE(max_flow.GetFlowCost() == GetCost(network, initial));
+    }
+}
+
+TEST_CASE("Min-cost flow with a negative cycle") {
+    CostNetwork network;
+    network.AddEdge(0, 1, 5, 1);
+    network.AddEdge(1, 2, 5, -1);
+    network.AddEdge(2, 1, 5, -1);
+    network.AddEdge(2, 3, 5, 1);
+    auto initial = network;
+    MinCostFlow min_cost_flow;
+    REQUIRE(!min_cost_flow.Run(4, network.edges, network.costs, 0, 3));
+    REQUIRE(network.edges == initial.edges);
+
+    MaxFlow max_flow;
+    size_t pushed_flow = 1;
+    Observer<MaxFlowData> network_observer(
+        [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+    max_flow.RegisterNetworkObserver(&network_observer);
+    max_flow.ChangeVerticesNumberRequest(4);
+    for (size_t i = 0; i < initial.edges.size(); i += 2) {
+        const auto& edge = initial.edges[i];
+        max_flow.AddEdgeRequest({edge.u, edge.to, edge.delta}, initial.costs[i]);
+    }
+    max_flow.RunRequest(Engine::MinCostFlow);
+    REQUIRE(pushed_flow == 0);
+    REQUIRE(max_flow.GetFlowCost() == 0);
+}
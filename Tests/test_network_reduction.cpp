@@ -0,0 +1,149 @@
+#include "catch.hpp"
+#include "../Kernel/max_flow.h"
+#include "../Kernel/network_reduction.h"
+#include "../Kernel/push_relabel.h"
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+using namespace observer_pattern;
+
+namespace {
+std::vector<BasicEdge> GenSparseGraph(std::mt19937& gen, size_t n) {
+    std::vector<BasicEdge> edges;
+    for (size_t i = 0; i < n + gen() % (n + 1); i++) {
+        size_t u = gen() % n, to = gen() % 3 ? (u + 1) % n : gen() % n;
+        edges.push_back({u, to, gen() % 10});
+    }
+    return edges;
+}
+
+// Every level wraps the previous one in a series chain and adds a parallel edge, so each
+// contraction enables exactly one merge and the next contraction.
+std::vector<BasicEdge> GenNestedNetwork(std::mt19937& gen, size_t depth) {
+    std::vector<BasicEdge> edges = {{0, 1, gen() % 100 + 1}};
+    for (size_t i = 1; i <= depth; i++) {
+        edges.push_back({2 * i, 2 * i + 1, gen() % 100 + 1});
+        edges.push_back({2 * i, 2 * i - 2, gen() % 100 + 1});
+        edges.push_back({2 * i - 1, 2 * i + 1, gen() % 100 + 1});
+    }
+    return edges;
+}
+
+size_t Solve(size_t n, const std::vector<BasicEdge>& edges, size_t source, size_t sink) {
+    ResidualNetwork network(n, edges);
+    PushRelabel push_relabel;
+    return push_relabel.Run(network, source, sink);
+}
+
+void CheckFlows(size_t n, const std::vector<BasicEdge>& edges, const std::vector<size_t>& flows,
+                size_t source, size_t sink, size_t flow) {
+    REQUIRE(flows.size() == edges.size());
+    std::vector<int64_t> balance(n);
+    for (size_t i = 0; i < edges.size(); i++) {
+        REQUIRE(flows[i] <= edges[i].delta);
+        balance[edges[i].u] -= static_cast<int64_t>(flows[i]);
+        balance[edges[i].to] += static_cast<int64_t>(flows[i]);
+    }
+    for (size_t vertex = 0; vertex < n; vertex++) {
+        if (vertex != source && vertex != sink) {
+            REQUIRE(balance[vertex] == 0);
+        }
+    }
+    REQUIRE(balance[sink] == static_cast<int64_t>(flow));
+}
+}  // namespace
+
+TEST_CASE("Network reduction basic") {
+    std::vector<BasicEdge> edges = {{0, 1, 5}, {1, 2, 3}, {2, 3, 7}, {0, 3, 2},
+                                    {0, 3, 1}, {4, 3, 9}, {0, 5, 4}};
+    NetworkReduction reduction;
+    reduction.Build(6, edges, 0, 3);
+    REQUIRE(reduction.GetVerticesNumber() == 2);
+    REQUIRE(reduction.GetEdges().size() == 1);
+    REQUIRE(reduction.GetEdges()[0].u == reduction.GetSource());
+    REQUIRE(reduction.GetEdges()[0].to == reduction.GetSink());
+    REQUIRE(reduction.GetEdges()[0].delta == 6);
+    auto flows = reduction.RestoreFlows({6});
+    REQUIRE(flows == std::vector<size_t>{3, 3, 3, 2, 1, 0, 0});
+}
+
+TEST_CASE("Network reduction keeps max flow") {
+    std::mt19937 gen(29);
+    NetworkReduction reduction;
+    for (size_t test = 0; test < 300; test++) {
+        size_t n = gen() % 15 + 2;
+        auto edges = GenSparseGraph(gen, n);
+        size_t source = gen() % n, sink = (source + gen() % (n - 1) + 1) % n;
+        reduction.Build(n, edges, source, sink);
+        REQUIRE(reduction.GetEdges().size() <= edges.size());
+        ResidualNetwork network(reduction.GetVerticesNumber(), reduction.GetEdges());
+        PushRelabel push_relabel;
+        size_t flow = push_relabel.Run(network, reduction.GetSource(), reduction.GetSink());
+        REQUIRE(flow == Solve(n, edges, source, sink));
+        std::vector<size_t> flows(reduction.GetEdges().size());
+        for (size_t i = 0; i < flows.size(); i++) {
+            flows[i] = network.GetFlow(i);
+        }
+        CheckFlows(n, edges, reduction.RestoreFlows(flows), source, sink, flow);
+    }
+}
+
+TEST_CASE("Network reduction of deep nesting") {
+    std::mt19937 gen(37);
+    const size_t depth = 50000, n = 2 * depth + 2;
+    auto edges = GenNestedNetwork(gen, depth);
+    NetworkReduction reduction;
+    reduction.Build(n, edges, n - 2, n - 1);
+    REQUIRE(reduction.GetVerticesNumber() == 2);
+    REQUIRE(reduction.GetEdges().size() == 1);
+    size_t flow = reduction.GetEdges()[0].delta;
+    REQUIRE(flow == Solve(n, edges, n - 2, n - 1));
+    CheckFlows(n, edges, reduction.RestoreFlows({flow}), n - 2, n - 1, flow);
+}
+
+TEST_CASE("Network reduction estimate") {
+    std::vector<BasicEdge> chain, complete;
+    const size_t n = 10;
+    for (size_t u = 0; u < n; u++) {
+        if (u + 1 < n) {
+            chain.push_back({u, u + 1, 1});
+        }
+        for (size_t to = 0; to < n; to++) {
+            complete.push_back({u, to, 1});
+        }
+    }
+    REQUIRE(NetworkReduction::IsWorthwhile(n, chain, 0, n - 1));
+    REQUIRE(!NetworkReduction::IsWorthwhile(n, complete, 0, n - 1));
+}
+
+TEST_CASE("Test reduced engines") {
+    std::mt19937 gen(31);
+    const std::vector<Engine> engines = {Engine::PushRelabel, Engine::ParallelPushRelabel,
+                                         Engine::BoykovKolmogorov,
+                                         Engine::DirectionOptimizingDinic, Engine::ParallelDinic};
+    for (size_t test = 0; test < 100; test++) {
+        size_t n = gen() % 15 + 2;
+        auto edges = GenSparseGraph(gen, n);
+        MaxFlow max_flow(n, edges);
+        MaxFlowData last_message;
+        Observer<MaxFlowData> network_observer(
+            [&last_message](const MaxFlowData& message) { last_message = message; });
+        max_flow.RegisterNetworkObserver(&network_observer);
+        max_flow.RunRequest(engines[gen() % engines.size()]);
+        REQUIRE(last_message.pushed_flow == Solve(n, edges, 0, n - 1));
+        std::vector<BasicEdge> merged_edges;
+        std::vector<size_t> flows;
+        for (size_t i = 0; i < last_message.edges.size(); i += 2) {
+            const auto& edge = last_message.edges[i];
+            merged_edges.push_back({edge.u, edge.to, edge.delta + last_message.edges[i + 1].delta});
+            flows.push_back(last_message.edges[i + 1].delta);
+        }
+        CheckFlows(n, merged_edges, flows, 0, n - 1, last_message.pushed_flow);
+        BasicEdge edge{gen() % n, gen() % n, gen() % 10 + 1};
+        max_flow.AddEdgeRequest(edge);
+        edges.push_back(edge);
+        max_flow.RunRequest(engines[gen() % engines.size()]);
+        REQUIRE(last_message.pushed_flow == Solve(n, edges, 0, n - 1));
+    }
+}
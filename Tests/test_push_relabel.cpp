@@ -0,0 +1,104 @@
+#include "catch.hpp"
+#include "../Kernel/max_flow.h"
+#include "../Kernel/push_relabel.h"
+#include "../Kernel/parallel_push_relabel.h"
+#include <random>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+using namespace observer_pattern;
+
+namespace {
+std::vector<BasicEdge> GenRandomEdges(std::mt19937& gen, size_t n, size_t m, size_t max_capacity) {
+    std::vector<BasicEdge> edges;
+    while (edges.size() < m) {
+        size_t u = gen() % n, to = gen() % n;
+        if (u != to) {
+            edges.push_back({u, to, gen() % max_capacity + 1});
+        }
+    }
+    return edges;
+}
+
+size_t SolveMaxFlow(size_t n, const std::vector<BasicEdge>& edges, Engine engine) {
+    MaxFlow max_flow(n, edges);
+    size_t pushed_flow = 0;
+    Observer<MaxFlowData> network_observer(
+        [&pushed_flow](const MaxFlowData& message) { pushed_flow = message.pushed_flow; });
+    max_flow.RegisterNetworkObserver(&network_observer);
+    max_flow.RunRequest(engine);
+    return pushed_flow;
+}
+}  // namespace
+
+TEST_CASE("Push-relabel basic") {
+    ResidualNetwork network(4, {{0, 1, 1}, {0, 2, 2}, {2, 1, 1}, {1, 3, 2}, {2, 3, 1}});
+    PushRelabel push_relabel;
+    REQUIRE(push_relabel.Run(network, 0, 3) == 3);
+    REQUIRE(network.GetFlow(0) == 1);
+    REQUIRE(network.GetFlow(1) == 2);
+    REQUIRE(network.GetFlow(2) == 1);
+    REQUIRE(network.GetFlow(3) == 2);
+    REQUIRE(network.GetFlow(4) == 1);
+}
+
+TEST_CASE("Push-relabel returns excess to the source") {
+    ResidualNetwork network(4, {{0, 1, 10}, {1, 2, 10}, {2, 3, 1}, {1, 3, 2}});
+    PushRelabel push_relabel;
+    REQUIRE(push_relabel.Run(network, 0, 3) == 3);
+    REQUIRE(network.GetFlow(0) == 3);
+    REQUIRE(network.GetFlow(1) == 1);
+}
+
+TEST_CASE("Push-relabel matches Dinic") {
+    std::mt19937 gen(7);
+    for (size_t test = 0; test < 200; test++) {
+        size_t n = gen() % 30 + 2;
+        auto edges = GenRandomEdges(gen, n, gen() % (4 * n), 50);
+        size_t expected = SolveMaxFlow(n, edges, Engine::Dinic);
+        REQUIRE(SolveMaxFlow(n, edges, Engine::PushRelabel) == expected);
+        REQUIRE(SolveMaxFlow(n, edges, Engine::ParallelPushRelabel) == expected);
+
+        ResidualNetwork network(n, edges);
+        ParallelPushRelabel parallel_push_relabel(2);
+        REQUIRE(parallel_push_relabel.Run(network, 0, n - 1) == expected);
+        network.Build(n, edges);
+        PushRelabel push_relabel;
+        REQUIRE(push_relabel.Run(network, 0, n - 1) == expected);
+        std::vector<ssize_t> balance(n);
+        for (size_t i = 0; i < edges.size(); i++) {
+            size_t flow = network.GetFlow(i);
+            REQUIRE(flow <= edges[i].delta);
+            balance[edges[i].u] -= flow;
+            balance[edges[i].to] += flow;
+        }
+        for (size_t vertex = 1; vertex + 1 < n; vertex++) {
+            REQUIRE(balance[vertex] == 0);
+        }
+        REQUIRE(balance[n - 1] == static_cast<ssize_t>(expected));
+    }
+}
+
+TEST_CASE("Parallel push-relabel produces a valid flow") {
+    std::mt19937 gen(11);
+    ParallelPushRelabel push_relabel(4);
+    for (size_t test = 0; test < 50; test++) {
+        size_t n = gen() % 200 + 2;
+        auto edges = GenRandomEdges(gen, n, gen() % (8 * n), 1000);
+        ResidualNetwork network(n, edges);
+        PushRelabel reference;
+        size_t expected = reference.Run(network, 0, n - 1);
+        network.Build(n, edges);
+        REQUIRE(push_relabel.Run(network, 0, n - 1) == expected);
+        std::vector<ssize_t> balance(n);
+        for (size_t i = 0; i < edges.size(); i++) {
+            size_t flow = network.GetFlow(i);
+            REQUIRE(flow <= edges[i].delta);
+            balance[edges[i].u] -= flow;
+            balance[edges[i].to] += flow;
+        }
+        for (size_t vertex = 1; vertex + 1 < n; vertex++) {
+            REQUIRE(balance[vertex] == 0);
+        }
+    }
+}
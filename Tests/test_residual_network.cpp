@@ -0,0 +1,50 @@
+#include "catch.hpp"
+#include "../Kernel/residual_network.h"
+#include <stdexcept>
+
+using namespace max_flow_app;
+using namespace kernel_messages;
+
+TEST_CASE("Residual network layout") {
+    ResidualNetwork network(4, {{0, 1, 3}, {2, 3, 1}, {0, 2, 2}, {1, 3, 4}});
+    REQUIRE(network.GetVerticesNumber() == 4);
+    REQUIRE(network.GetEdgesNumber() == 4);
+    REQUIRE(network.GetArcsNumber() == 8);
+    REQUIRE(network.End(0) - network.Begin(0) == 2);
+    REQUIRE(network.End(1) - network.Begin(1) == 2);
+    REQUIRE(network.End(2) - network.Begin(2) == 2);
+    REQUIRE(network.End(3) - network.Begin(3) == 2);
+    for (size_t vertex = 0; vertex < 4; vertex++) {
+        for (size_t i = network.Begin(vertex); i < network.End(vertex); i++) {
+            size_t reverse = network.GetReverse(i);
+            REQUIRE(network.GetReverse(reverse) == i);
+            REQUIRE(network.GetHead(reverse) == vertex);
+        }
+    }
+    size_t index = network.GetEdgeArc(2);
+    REQUIRE(network.GetHead(index) == 2);
+    REQUIRE(network.GetResidual(index) == 2);
+}
+
+TEST_CASE("Residual network push") {
+    ResidualNetwork network(3, {{0, 1, 5}, {1, 2, 3}});
+    network.Push(network.GetEdgeArc(0), 2);
+    network.Push(network.GetEdgeArc(1), 2);
+    REQUIRE(network.GetFlow(0) == 2);
+    REQUIRE(network.GetFlow(1) == 2);
+    REQUIRE(network.GetResidual(network.GetEdgeArc(0)) == 3);
+    network.Push(network.GetReverse(network.GetEdgeArc(1)), 1);
+    REQUIRE(network.GetFlow(1) == 1);
+}
+
+TEST_CASE("Residual network index limit") {
+    const size_t max_arcs = ResidualNetwork::kMaxArcsNumber;
+    REQUIRE(ResidualNetwork::IsIndexable(max_arcs, max_arcs >> 1));
+    REQUIRE(!ResidualNetwork::IsIndexable(max_arcs + 1, 0));
+    REQUIRE(!ResidualNetwork::IsIndexable(0, (max_arcs >> 1) + 1));
+
+    ResidualNetwork network(2, {{0, 1, 1}});
+    REQUIRE_THROWS_AS(network.Build(max_arcs + 1, {}), std::length_error);
+    REQUIRE(network.GetVerticesNumber() == 2);
+    REQUIRE(network.GetEdgesNumber() == 1);
+}